@@ -0,0 +1,133 @@
+const { BasePlugin } = require('appium/plugin');
+
+const ELEMENT_KEYS = ['element-6066-11e4-a52e-4f735466cecf', 'ELEMENT'];
+const POLL_INTERVAL = 250;
+
+function elementIdOf(element) {
+    return ELEMENT_KEYS.map((key) => element[key]).find(Boolean);
+}
+
+function sleep(ms) {
+    return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+/**
+ * Appium plugin adding POST /session/:sessionId/appium/macro. The body holds an ordered list of steps that
+ * run on the server against the session's driver, so a flow of finds, clicks and typing costs one HTTP round
+ * trip instead of one per command.
+ *
+ * Step shape:
+ *   { using, value }                                   locate (waits up to timeout)
+ *   { using, value, action: 'click' | 'clear' | 'text' | 'waitForDisplayed' }
+ *   { using, value, action: 'setValue', text }         clear, then type/replace
+ *   { using, value, assert: { exists, displayed, text } }
+ *   { action: 'hideKeyboard' }
+ *   { action: 'execute', script, args }
+ *   { action: 'pause', ms }
+ *
+ * Responds with { steps: [{ index, action, elementId, result, duration }], duration }. The first failing step
+ * stops the macro with an error naming the step.
+ */
+class MacroPlugin extends BasePlugin {
+    static newMethodMap = {
+        '/session/:sessionId/appium/macro': {
+            POST: {
+                command: 'runMacro',
+                payloadParams: { required: ['steps'], optional: ['timeout'] },
+            },
+        },
+    };
+
+    async runMacro(next, driver, steps, timeout = 10000) {
+        const started = Date.now();
+        const results = [];
+
+        for (const [index, step] of steps.entries()) {
+            const stepStarted = Date.now();
+            try {
+                const elementId = step.using ? await this.locate(driver, step, timeout) : undefined;
+                const result = await this.act(driver, step, elementId, timeout);
+                if (step.assert) {
+                    await this.verify(driver, step, elementId);
+                }
+                results.push({ index, action: step.action || (step.assert ? 'assert' : 'locate'), elementId, result, duration: Date.now() - stepStarted });
+            } catch (error) {
+                error.message = `Macro step ${index} (${step.action || 'locate'} ${step.using ? `${step.using}=${step.value}` : ''}) failed: ${error.message}`;
+                throw error;
+            }
+        }
+        return { steps: results, duration: Date.now() - started };
+    }
+
+    /**
+     * Finds the step's element, polling until the timeout like WebdriverIO's implicit waits. Steps asserting
+     * absence resolve to undefined instead of failing.
+     */
+    async locate(driver, { using, value, assert }, timeout) {
+        const deadline = Date.now() + timeout;
+        for (;;) {
+            const [element] = await driver.findElements(using, value);
+            if (element) {
+                return elementIdOf(element);
+            }
+            if (assert && assert.exists === false) {
+                return undefined;
+            }
+            if (Date.now() >= deadline) {
+                throw new Error(`no element found within ${timeout}ms`);
+            }
+            await sleep(POLL_INTERVAL);
+        }
+    }
+
+    async act(driver, step, elementId, timeout) {
+        switch (step.action) {
+            case undefined:
+                return undefined;
+            case 'click':
+                return driver.click(elementId);
+            case 'clear':
+                return driver.clear(elementId);
+            case 'setValue':
+                await driver.clear(elementId);
+                return driver.setValue(String(step.text), elementId);
+            case 'text':
+                return driver.getText(elementId);
+            case 'waitForDisplayed': {
+                const deadline = Date.now() + (step.timeout ?? timeout);
+                while (!(await driver.elementDisplayed(elementId))) {
+                    if (Date.now() >= deadline) {
+                        throw new Error('element not displayed');
+                    }
+                    await sleep(POLL_INTERVAL);
+                }
+                return true;
+            }
+            case 'hideKeyboard':
+                return driver.hideKeyboard();
+            case 'execute':
+                return driver.execute(step.script, step.args ? [step.args] : []);
+            case 'pause':
+                return sleep(step.ms);
+            default:
+                throw new Error(`unknown action "${step.action}"`);
+        }
+    }
+
+    async verify(driver, { assert }, elementId) {
+        if (assert.exists !== undefined && Boolean(elementId) !== assert.exists) {
+            throw new Error(`expected element to ${assert.exists ? '' : 'not '}exist`);
+        }
+        if (assert.displayed !== undefined && (await driver.elementDisplayed(elementId)) !== assert.displayed) {
+            throw new Error(`expected element to ${assert.displayed ? '' : 'not '}be displayed`);
+        }
+        if (assert.text !== undefined) {
+            const text = await driver.getText(elementId);
+            if (text !== assert.text) {
+                throw new Error(`expected text "${assert.text}" but found "${text}"`);
+            }
+        }
+    }
+}
+
+module.exports = { MacroPlugin };
@@ -0,0 +1,2 @@
+// Loaded by mochaOpts.require in every worker; a no-op unless TEST_SHARD or TEST_SHARDS is set.
+require('../utilities/testSharding').register();
@@ -0,0 +1,34 @@
+const { config } = require('./wdio.conf');
+const CommandLatencyService = require('../services/CommandLatencyService');
+const TraceService = require('../services/TraceService');
+const SpecSchedulerService = require('../services/SpecSchedulerService');
+const SessionStartupService = require('../services/SessionStartupService');
+const FrameMetrics = require('../utilities/FrameMetrics');
+const { selectCapabilities } = require('../utilities/platformSelection');
+
+// Services that measure or reorder the suite and would add their own overhead to every timed journey.
+const instrumentation = [CommandLatencyService, TraceService, SpecSchedulerService, SessionStartupService, 'visual'];
+
+// Benchmark mode: runs the journeys in src/tests/benchmarks BENCHMARK_ITERATIONS times each (default from
+// src/data/performance-budgets.json) and fails when a journey or step exceeds its budget. Benchmarks directly in
+// src/tests/benchmarks (cart seeding) run on every platform. wdio.conf.js already dropped the platforms the host
+// cannot run, but chose by the regular specs, so the --spec selection is applied again to the benchmark specs:
+// '--spec ./src/tests/benchmarks/android/app-start.bench.js' then only starts the Android capability.
+exports.config = {
+    ...config,
+    capabilities: selectCapabilities(config.capabilities.map((capability) => ({
+        ...capability,
+        specs: [`../tests/benchmarks/${capability.platformName.toLowerCase()}/**/*.bench.js`, '../tests/benchmarks/*.bench.js'],
+    })), { checkHost: false }),
+    services: config.services.filter((service) => !instrumentation.includes([].concat(service)[0])),
+    reporters: [],
+    mochaOpts: {
+        ui: 'bdd',
+        timeout: 60 * 60 * 1000,
+    },
+
+    // No failure screenshots: a failing journey throws, and screenshots would skew the timings of the next one.
+    afterTest: function (test) {
+        FrameMetrics.attach(test);
+    },
+};
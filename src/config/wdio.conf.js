@@ -1,41 +1,121 @@
+const CommandTimingService = require('../services/CommandTimingService');
+const CommandLatencyService = require('../services/CommandLatencyService');
+const TraceService = require('../services/TraceService');
+const SpecSchedulerService = require('../services/SpecSchedulerService');
+const EmulatorFarmService = require('../services/EmulatorFarmService');
+const AppProvisioningService = require('../services/AppProvisioningService');
+const SessionStartupService = require('../services/SessionStartupService');
+const TrendService = require('../services/TrendService');
+const Timeline = require('../utilities/instrumentation/Timeline');
+const FrameMetrics = require('../utilities/FrameMetrics');
+const WebDriverRecorderService = require('../services/webdriver-recorder/WebDriverRecorderService');
+const SessionBrokerService = require('../services/session-broker/SessionBrokerService');
+const { expandCapabilities, clearClaims } = require('../utilities/testSharding');
+const { selectCapabilities, appiumPorts } = require('../utilities/platformSelection');
+
+// WEBDRIVER_MODE=record proxies Appium and stores every WebDriver request/response under ./recordings/<RECORDING_NAME>;
+// WEBDRIVER_MODE=replay serves that recording instead of Appium, so the suite runs without a device.
+const webdriverMode = process.env.WEBDRIVER_MODE;
+const recorderOptions = {
+    mode: webdriverMode,
+    port: 4730,
+    targetPort: 4723,
+    name: process.env.RECORDING_NAME || 'latest',
+    latency: process.env.REPLAY_LATENCY || 'none',
+};
+
+// SESSION_POOL=1 puts a session broker on 4731 that creates the next session while the current spec runs, spread over
+// the SESSION_POOL_DEVICES serials/UDIDs (comma separated). Not combined with WEBDRIVER_MODE.
+const sessionBrokerOptions = {
+    port: 4731,
+    targetPort: 4723,
+    devices: (process.env.SESSION_POOL_DEVICES || '').split(',').filter(Boolean),
+};
+const sessionPool = Boolean(process.env.SESSION_POOL) && !webdriverMode;
+
+// TEST_SHARDS=n runs every capability on n devices and splits the tests of each spec file between them.
+const testShards = Number(process.env.TEST_SHARDS || 0);
+
+// PERF_VERBOSE=1 prints each worker's app reset, fixture and element cache statistics when it ends.
+const perfVerbose = Boolean(process.env.PERF_VERBOSE);
+
+// APPIUM_MACRO_PLUGIN=1 enables the macro plugin (install once with
+// 'appium plugin install --source=local ./src/appium-plugins/macro'); page objects fall back to single commands without it.
+const appiumPluginArgs = process.env.APPIUM_MACRO_PLUGIN ? { usePlugins: 'macro' } : {};
+
+// EMULATOR_FARM=n boots n headless emulators of EMULATOR_FARM_AVD, each with its own Appium server, and replaces the
+// Android capability below with one capability per device.
+const emulatorFarmOptions = {
+    devices: Number(process.env.EMULATOR_FARM || 0),
+    avd: process.env.EMULATOR_FARM_AVD,
+    appiumArgs: appiumPluginArgs,
+};
+
+// Only capabilities whose specs were selected (--spec) and whose platform the host can run are kept; iOS needs macOS.
+const capabilities = selectCapabilities([
+    // capabilities for local Appium web tests on an Android Emulator
+    {
+        platformName: 'Android',
+        'appium:App': '/Users/vincentpace/Development/qa/caesars-mobile-exercise/mda-2.2.0-25.apk',
+        'appium:deviceName': 'Android GoogleAPI Emulator',
+        'appium:platformVersion': '16.0',
+        'appium:automationName': 'UiAutomator2',
+        'appium:appPackage': 'com.saucelabs.mydemoapp.android',
+        'appium:appActivity': 'com.saucelabs.mydemoapp.android.view.activities.SplashActivity',
+        specs: ['../tests/specs/android/**/*.js']
+    },
+    // {
+    //     platformName: 'iOS',
+    //     'appium:App': '/Users/vincentpace/Development/qa/caesars-mobile-exercise/Payload/My Demo App.ipa',
+    //     'appium:deviceName': 'iPhone 17 Pro Max',
+    //     'appium:platformVersion': '26.0',
+    //     'appium:automationName': 'XCUITest',
+    //     'appium:bundleId': 'com.saucelabs.mydemo.app.ios',
+    //     port: 4725,
+    //     specs: ['../../tests/specs/ios/**/*.js']
+    // },
+
+    // capabilities for local Appium web tests on an iOS iPad Pro (12.9-inch) Simulator
+    {
+        platformName: 'iOS',
+        'appium:App': '/Users/vincentpace/Development/qa/caesars-mobile-exercise/Payload/My Demo App.ipa',
+        'appium:deviceName': 'iPad Pro (12.9-inch) (6th generation) (16GB)',
+        'appium:platformVersion': '26.0',
+        'appium:automationName': 'XCUITest',
+        'appium:bundleId': 'com.saucelabs.mydemo.app.ios',
+        specs: ['../tests/specs/ios/**/*.js']
+    }
+], { checkHost: webdriverMode !== 'replay' });
+
+// One Appium server per port the active capabilities connect to; none when replaying, and farm devices bring their own.
+// Logs are timestamped so SessionStartupService can break session creation into phases.
+const appiumServices = appiumPorts(
+    capabilities.filter((capability) => !(emulatorFarmOptions.devices && capability.platformName === 'Android')),
+    webdriverMode === 'replay' ? null : recorderOptions.targetPort,
+).map((port) => ['appium', {
+    logPath : './',
+    logFileName: `appium-${port}.log`,
+    args: {
+        port,
+        logTimestamp: true,
+        localTimezone: true,
+        ...appiumPluginArgs,
+    },
+    command: 'appium',
+}]);
+
+// VISUAL=1 enables the visual service and its baselines.
+const visualServices = process.env.VISUAL ? ['visual'] : [];
+
 exports.config = {
     runner: 'local',
-    port: 4723,
-    maxInstances: 2,
-    capabilities: [
-        // capabilities for local Appium web tests on an Android Emulator
-        {
-            platformName: 'Android',
-            'appium:App': '/Users/vincentpace/Development/qa/caesars-mobile-exercise/mda-2.2.0-25.apk',
-            'appium:deviceName': 'Android GoogleAPI Emulator',
-            'appium:platformVersion': '16.0',
-            'appium:automationName': 'UiAutomator2',
-            'appium:appPackage': 'com.saucelabs.mydemoapp.android',
-            'appium:appActivity': 'com.saucelabs.mydemoapp.android.view.activities.SplashActivity',
-            specs: ['../tests/specs/android/**/*.js']
-        },
-        // {
-        //     platformName: 'iOS',
-        //     'appium:App': '/Users/vincentpace/Development/qa/caesars-mobile-exercise/Payload/My Demo App.ipa',
-        //     'appium:deviceName': 'iPhone 17 Pro Max',
-        //     'appium:platformVersion': '26.0',
-        //     'appium:automationName': 'XCUITest',
-        //     'appium:bundleId': 'com.saucelabs.mydemo.app.ios',
-        //     port: 4725,
-        //     specs: ['../../tests/specs/ios/**/*.js']
-        // },
-
-        // capabilities for local Appium web tests on an iOS iPad Pro (12.9-inch) Simulator
-        {
-            platformName: 'iOS',
-            'appium:App': '/Users/vincentpace/Development/qa/caesars-mobile-exercise/Payload/My Demo App.ipa',
-            'appium:deviceName': 'iPad Pro (12.9-inch) (6th generation) (16GB)',
-            'appium:platformVersion': '26.0',
-            'appium:automationName': 'XCUITest',
-            'appium:bundleId': 'com.saucelabs.mydemo.app.ios',
-            specs: ['../tests/specs/ios/**/*.js']
-        }
-    ],
+    port: webdriverMode ? recorderOptions.port : sessionPool ? sessionBrokerOptions.port : 4723,
+    // Every shard copy of every capability runs at the same time.
+    maxInstances: Math.max(2, testShards * capabilities.length),
+    capabilities: expandCapabilities(capabilities, testShards, {
+        devicesAssigned: (capability) => webdriverMode === 'replay'
+            || Boolean(emulatorFarmOptions.devices && capability.platformName === 'Android'),
+    }),
 
     logLevel: 'info',
     bail: 0,
@@ -43,25 +123,48 @@ exports.config = {
     connectionRetryTimeout: 120000,
     connectionRetryCount: 3,
     services: [
-        ['appium', {
-            logPath : './',
-            args: {
-                port: 4723
-            },
-            command: 'appium',
-        }],
-        ['appium', {
-            logPath : './',
-            args: {
-                port: 4725
-            },
-            command: 'appium',
-        }],'visual'],
+        ...appiumServices,
+        ...visualServices,
+        ...(webdriverMode ? [[WebDriverRecorderService, recorderOptions]] : []),
+        ...(sessionPool ? [[SessionBrokerService, sessionBrokerOptions]] : []),
+        ...(emulatorFarmOptions.devices ? [[EmulatorFarmService, emulatorFarmOptions]] : []),
+        // Times commands once for the latency, trace and trend services below.
+        CommandTimingService,
+        [CommandLatencyService, { outputDir: './reports' }],
+        [TraceService, { outputDir: './reports/traces' }],
+        // A replay serves recorded durations, which would only skew the spec history.
+        ...(webdriverMode === 'replay' ? [] : [[SpecSchedulerService, { historyFile: './.perf/spec-history.json' }]]),
+        [TrendService, { storeFile: './.perf/trends.ndjson' }],
+        ...(webdriverMode === 'replay' ? [] : [[AppProvisioningService, { recordDir: './.perf/provisioning' }]]),
+        ...(webdriverMode === 'replay' ? [] : [[SessionStartupService, { logDir: './', historyFile: './.perf/session-startup.jsonl' }]]),
+    ],
     framework: 'mocha',
     reporters: ['spec'],
     mochaOpts: {
         ui: 'bdd',
-        timeout: 60000
+        timeout: 60000,
+        require: [require.resolve('./mocha.testShard')],
+    },
+
+    /**
+     * Gets executed once before all workers get launched.
+     * @param {object} config wdio configuration object
+     * @param {Array.<Object>} capabilities list of capabilities details
+     */
+    onPrepare: function (config, capabilities) {
+        // Claims of earlier dynamic-shard runs would otherwise pile up under ./.perf/test-claims.
+        clearClaims();
+    },
+
+    /**
+     * Gets executed before test execution begins. At this point you can access to all global
+     * variables like `browser`. It is the perfect place to define custom commands.
+     * @param {Array.<Object>} capabilities list of capabilities details
+     * @param {Array.<String>} specs        List of spec file paths that are to be run
+     * @param {object}         browser      instance of created browser/device session
+     */
+    before: function (capabilities, specs, browser) {
+        require('../utilities/MacroClient').register(browser);
     },
 
     /**
@@ -75,14 +178,48 @@ exports.config = {
      * @param {object}  result.retries   information about spec related retries, e.g. `{ attempts: 0, limit: 0 }`
      */
     afterTest: async function (test, context, { error, result, duration, passed, retries }) {
+        FrameMetrics.attach(test);
         if (error) {
             // Generate a unique filename for the screenshot
             const screenshotName = `failure_${test.title.replace(/\s/g, '_')}_${Date.now()}.png`;
             const screenshotPath = `./screenshots/${screenshotName}`;
 
             // Take the screenshot
-            await browser.saveScreenshot(screenshotPath);
+            await Timeline.span('failure screenshot', 'afterTest', () => browser.saveScreenshot(screenshotPath));
             console.log(`Screenshot saved for failed test: ${screenshotPath}`);
         }
     },
+
+    /**
+     * Runs after a WebdriverIO command gets executed
+     * @param {string} commandName hook command name
+     * @param {Array} args arguments that command would receive
+     * @param {*} result result of the command
+     * @param {Error} error error in case something went wrong
+     */
+    afterCommand: async function (commandName, args, result, error) {
+        require('../utilities/ElementCache').handleCommandError(error);
+        await require('../utilities/page-source/capture').capturePageSource(commandName);
+    },
+
+    /**
+     * Gets executed after all tests are done. You still have access to all global variables from the test.
+     * @param {number}          result        0 - test pass, 1 - test fail
+     * @param {Array.<Object>}  capabilities  list of capabilities details
+     * @param {Array.<String>}  specs         list of spec file paths that ran
+     */
+    after: function (result, capabilities, specs) {
+        if (!perfVerbose) {
+            return;
+        }
+        const AppStateReset = require('../utilities/AppStateReset');
+        for (const [strategy, summary] of Object.entries(AppStateReset.report())) {
+            console.log(`App reset via ${strategy}: ${summary.count} resets, mean ${summary.mean}ms, p95 ${summary.p95}ms, max ${summary.max}ms`);
+        }
+        for (const [phase, summary] of Object.entries(require('../utilities/Fixtures').report())) {
+            console.log(`Fixture ${phase}: ${summary.count} times, mean ${summary.mean}ms, p95 ${summary.p95}ms`);
+        }
+        const cache = require('../utilities/ElementCache').stats();
+        console.log(`Element cache: ${cache.hits} hits, ${cache.misses} misses (${Math.round(cache.hitRate * 100)}% hit rate), ${cache.invalidations} stale invalidations`);
+    },
 }
\ No newline at end of file
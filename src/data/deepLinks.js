@@ -0,0 +1,24 @@
+/**
+ * URL scheme routes understood by the Sauce Labs demo apps. Routes must match the installed app build;
+ * platform specific overrides go in the android/ios maps.
+ */
+module.exports = {
+    scheme: 'mydemoapp://',
+    routes: {
+        catalog: 'store',
+        product: 'product-details/{id}',
+        cart: 'cart/{items}',
+        checkout: 'checkout-address',
+        payment: 'checkout-payment',
+    },
+    android: {},
+    ios: {},
+    products: {
+        backpack: { id: 1, name: 'Sauce Labs Backpack', price: 29.99 },
+        bikeLight: { id: 2, name: 'Sauce Labs Bike Light', price: 9.99 },
+        boltTShirt: { id: 3, name: 'Sauce Labs Bolt T-Shirt', price: 15.99 },
+        fleeceJacket: { id: 4, name: 'Sauce Labs Fleece Jacket', price: 49.99 },
+        onesie: { id: 5, name: 'Sauce Labs Onesie', price: 7.99 },
+        redTShirt: { id: 6, name: 'Test.allTheThings() T-Shirt', price: 15.99 },
+    },
+};
@@ -0,0 +1,141 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { adb, shell } = require('../utilities/adb');
+const { appHash, setProvisionedArtifact } = require('../utilities/appArtifact');
+
+const UIA2_SERVER_PACKAGE = 'io.appium.uiautomator2.server';
+const UIA2_TEST_PACKAGE = 'io.appium.uiautomator2.server.test';
+
+/**
+ * Skips app and UiAutomator2 server installs on Android devices that already have exactly the build under test.
+ * The APK is hashed on the host and the hash is recorded per device after a session installed it, together
+ * with the package's lastUpdateTime (so a reinstall outside the test run invalidates the record). When both
+ * still match, the session starts without appium:App, with noReset and a 'pm clear', which leaves the same
+ * clean state as a fresh install. The server APKs are skipped when the installed version is the one the
+ * UiAutomator2 driver ships.
+ *
+ * Options:
+ *   recordDir  provisioning records, one file per device, default './.perf/provisioning'
+ */
+module.exports = class AppProvisioningService {
+    constructor(options = {}) {
+        this.recordDir = path.resolve(options.recordDir || './.perf/provisioning');
+    }
+
+    async beforeSession(config, capabilities) {
+        const apk = capabilities['appium:App'] || capabilities['appium:app'];
+        const appPackage = capabilities['appium:appPackage'];
+        if (capabilities.platformName !== 'Android' || !apk || !appPackage) {
+            return;
+        }
+        const serial = capabilities['appium:udid'] || await this.onlyDevice();
+        if (!serial) {
+            return;
+        }
+        this.pending = { serial, appPackage, hash: appHash(apk) };
+
+        try {
+            const record = this.read(serial)[appPackage];
+            const installed = await this.lastUpdateTime(serial, appPackage);
+            if (record && installed && record.hash === this.pending.hash && record.lastUpdateTime === installed) {
+                // Capabilities only change once the data is cleared; a failed clear leaves a normal install.
+                await shell(serial, 'pm', 'clear', appPackage);
+                delete capabilities['appium:App'];
+                delete capabilities['appium:app'];
+                capabilities['appium:noReset'] = true;
+                setProvisionedArtifact(apk);
+                this.pending = null;
+                console.log(`Provisioning: ${appPackage} on ${serial} is up to date, skipping install`);
+            }
+        } catch (error) {
+            console.warn(`Provisioning: ${error.message}, installing as usual`);
+        }
+        try {
+            if (await this.serverIsCurrent(serial)) {
+                capabilities['appium:skipServerInstallation'] = true;
+            }
+        } catch (error) {
+            console.warn(`Provisioning: ${error.message}, installing the UiAutomator2 server as usual`);
+        }
+    }
+
+    /**
+     * Records what the session just installed, once the session (and so the install) exists.
+     */
+    async before() {
+        if (!this.pending) {
+            return;
+        }
+        const { serial, appPackage, hash } = this.pending;
+        const lastUpdateTime = await this.lastUpdateTime(serial, appPackage).catch(() => null);
+        if (hash && lastUpdateTime) {
+            // One file per device, replaced atomically, so parallel workers on other devices cannot lose this record.
+            const records = { ...this.read(serial), [appPackage]: { hash, lastUpdateTime, recordedAt: new Date().toISOString() } };
+            const file = this.recordFile(serial);
+            const temporary = `${file}.${process.pid}.tmp`;
+            fs.mkdirSync(this.recordDir, { recursive: true });
+            fs.writeFileSync(temporary, JSON.stringify(records, null, 2));
+            fs.renameSync(temporary, file);
+        }
+    }
+
+    recordFile(serial) {
+        return path.join(this.recordDir, `${serial.replace(/[^\w.-]/g, '_')}.json`);
+    }
+
+    read(serial) {
+        const file = this.recordFile(serial);
+        return fs.existsSync(file) ? JSON.parse(fs.readFileSync(file, 'utf8')) : {};
+    }
+
+    async onlyDevice() {
+        const output = await adb(undefined, ['devices']).catch(() => '');
+        const devices = output.split('\n').slice(1).filter((line) => line.endsWith('\tdevice')).map((line) => line.split('\t')[0]);
+        return process.env.ANDROID_SERIAL || (devices.length === 1 ? devices[0] : undefined);
+    }
+
+    async lastUpdateTime(serial, appPackage) {
+        const dump = await shell(serial, 'dumpsys', 'package', appPackage);
+        return (dump.match(/lastUpdateTime=([^\r\n]+)/) || [])[1]?.trim() || null;
+    }
+
+    async installedVersion(serial, appPackage) {
+        const dump = await shell(serial, 'dumpsys', 'package', appPackage);
+        return (dump.match(/versionName=([^\s]+)/) || [])[1] || null;
+    }
+
+    /**
+     * True when both server packages are installed and the server has the version bundled with the driver.
+     */
+    async serverIsCurrent(serial) {
+        const expected = bundledServerVersion();
+        if (!expected) {
+            return false;
+        }
+        const [server, test] = await Promise.all([
+            this.installedVersion(serial, UIA2_SERVER_PACKAGE),
+            shell(serial, 'pm', 'path', UIA2_TEST_PACKAGE).then((output) => output.trim() !== '', () => false),
+        ]);
+        return server === expected && test;
+    }
+};
+
+/**
+ * Version of the UiAutomator2 server APK shipped with the installed driver, looked up in the project's
+ * node_modules and in APPIUM_HOME.
+ */
+function bundledServerVersion() {
+    const roots = [process.cwd(), process.env.APPIUM_HOME || path.join(os.homedir(), '.appium')];
+    for (const root of roots) {
+        for (const file of [
+            path.join(root, 'node_modules/appium-uiautomator2-server/package.json'),
+            path.join(root, 'node_modules/appium-uiautomator2-driver/node_modules/appium-uiautomator2-server/package.json'),
+        ]) {
+            if (fs.existsSync(file)) {
+                return JSON.parse(fs.readFileSync(file, 'utf8')).version;
+            }
+        }
+    }
+    return undefined;
+}
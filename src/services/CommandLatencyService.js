@@ -0,0 +1,142 @@
+const fs = require('fs');
+const path = require('path');
+const CommandTimer = require('../utilities/instrumentation/CommandTimer');
+const { summarize, histogram } = require('../utilities/stats');
+
+const ELEMENT_KEY = 'element-6066-11e4-a52e-4f735466cecf';
+
+/**
+ * Records the latency of every WebDriver command and attributes it to the page-object method that issued
+ * it and to the selector it targets. Each worker writes command-latency-<cid>.json to outputDir; the launcher
+ * merges them into command-latency.json and prints the slowest page-object methods. Commands are timed by
+ * CommandTimer (see CommandTimingService).
+ *
+ * Options:
+ *   outputDir  directory for the JSON artifacts, default './reports'
+ *   top        number of page-object methods printed at the end of the run, default 10
+ */
+module.exports = class CommandLatencyService {
+    constructor(options = {}) {
+        this.outputDir = path.resolve(options.outputDir || './reports');
+        this.top = options.top || 10;
+        this.pending = new Map();
+        this.samples = [];
+        this.selectors = new Map();
+    }
+
+    onPrepare() {
+        if (fs.existsSync(this.outputDir)) {
+            fs.readdirSync(this.outputDir)
+                .filter((file) => /^command-latency-.+\.json$/.test(file))
+                .forEach((file) => fs.rmSync(path.join(this.outputDir, file)));
+        }
+    }
+
+    /**
+     * Adds the HTTP round trip of each request to the command that sent it, so the split-latency report can tell
+     * client overhead from time on the wire.
+     */
+    before(capabilities, specs, browser) {
+        browser.on('request.performance', ({ durationMillisecond }) => {
+            const sample = this.pending.get(CommandTimer.current());
+            if (sample) {
+                sample.http = (sample.http || 0) + Math.round(durationMillisecond);
+            }
+        });
+        CommandTimer.subscribe((event, command) => (event === 'start' ? this.started(command) : this.ended(command)));
+    }
+
+    started(command) {
+        this.pending.set(command, {
+            command: command.commandName,
+            method: command.path || '(spec)',
+            selector: this.selectorFor(command.commandName, command.args),
+            nested: command.nested,
+            start: command.start,
+        });
+    }
+
+    ended(command) {
+        const sample = this.pending.get(command);
+        if (!sample) {
+            return;
+        }
+        this.pending.delete(command);
+        const { commandName, args, result, error } = command;
+        sample.end = command.end;
+        sample.duration = command.duration;
+        sample.sessionId = driver.sessionId;
+        sample.failed = Boolean(error);
+        this.samples.push(sample);
+
+        if (['findElement', 'findElements'].includes(commandName) && result) {
+            for (const element of [].concat(result)) {
+                if (element && element[ELEMENT_KEY]) {
+                    this.selectors.set(element[ELEMENT_KEY], `${args[0]}:${args[1]}`);
+                }
+            }
+        }
+    }
+
+    /**
+     * Resolves the selector a command targets: find commands carry it, element commands reference an element
+     * id that was returned by an earlier find.
+     */
+    selectorFor(commandName, args) {
+        if (['findElement', 'findElements'].includes(commandName)) {
+            return `${args[0]}:${args[1]}`;
+        }
+        if (typeof args[0] === 'string' && this.selectors.has(args[0])) {
+            return this.selectors.get(args[0]);
+        }
+        return null;
+    }
+
+    after() {
+        fs.mkdirSync(this.outputDir, { recursive: true });
+        const file = path.join(this.outputDir, `command-latency-${process.env.WDIO_WORKER_ID || process.pid}.json`);
+        fs.writeFileSync(file, JSON.stringify({ samples: this.samples }, null, 2));
+    }
+
+    onComplete() {
+        if (!fs.existsSync(this.outputDir)) {
+            return;
+        }
+        const samples = fs.readdirSync(this.outputDir)
+            .filter((file) => /^command-latency-.+\.json$/.test(file))
+            .flatMap((file) => JSON.parse(fs.readFileSync(path.join(this.outputDir, file), 'utf8')).samples);
+        if (samples.length === 0) {
+            return;
+        }
+
+        const report = {
+            byMethod: group(samples.filter((sample) => !sample.nested), (sample) => sample.method),
+            bySelector: group(samples.filter((sample) => sample.selector), (sample) => sample.selector),
+            byCommand: group(samples, (sample) => sample.command),
+        };
+        fs.writeFileSync(path.join(this.outputDir, 'command-latency.json'), JSON.stringify(report, null, 2));
+
+        console.log('Slowest page-object methods by total command time:');
+        Object.entries(report.byMethod)
+            .sort(([, a], [, b]) => b.total - a.total)
+            .slice(0, this.top)
+            .forEach(([method, stats]) => {
+                console.log(`  ${method}: ${stats.count} commands, total ${stats.total}ms, p50 ${stats.p50}ms, p95 ${stats.p95}ms, p99 ${stats.p99}ms`);
+            });
+    }
+};
+
+/**
+ * Groups samples by key and summarizes each group's durations.
+ */
+function group(samples, keyOf) {
+    const groups = {};
+    for (const sample of samples) {
+        (groups[keyOf(sample)] = groups[keyOf(sample)] || []).push(sample.duration);
+    }
+    return Object.fromEntries(Object.entries(groups).map(([key, durations]) => [key, {
+        ...summarize(durations),
+        total: durations.reduce((sum, value) => sum + value, 0),
+        histogram: histogram(durations),
+    }]));
+}
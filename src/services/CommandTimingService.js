@@ -0,0 +1,22 @@
+const PageObjectTracer = require('../utilities/instrumentation/PageObjectTracer');
+const CommandTimer = require('../utilities/instrumentation/CommandTimer');
+
+/**
+ * Worker service that feeds CommandTimer from the command hooks and instruments page objects (loaded ones and any
+ * required later), once for all the services that measure commands (CommandLatencyService, TraceService,
+ * TrendService). List it before them.
+ */
+module.exports = class CommandTimingService {
+    before() {
+        PageObjectTracer.instrumentLoadedModules();
+        PageObjectTracer.instrumentOnRequire();
+    }
+
+    beforeCommand(commandName, args) {
+        CommandTimer.start(commandName, args);
+    }
+
+    afterCommand(commandName, args, result, error) {
+        CommandTimer.end(commandName, args, result, error);
+    }
+};
@@ -0,0 +1,248 @@
+const fs = require('fs');
+const net = require('net');
+const os = require('os');
+const path = require('path');
+const { spawn } = require('child_process');
+const { adb, shell } = require('../utilities/adb');
+const { appHash } = require('../utilities/appArtifact');
+
+const BOOT_POLL_INTERVAL = 2000;
+
+/**
+ * Launcher service that boots a farm of headless Android emulators and generates one capability per device.
+ * Every emulator boots read-only from the same quick-boot snapshot (which has the app preinstalled), gets its
+ * own console port/adb serial, its own Appium server and its own UiAutomator2 system port. A single Android
+ * capability in the config is used as the template and replaced by one copy per device; several Android
+ * capabilities (e.g. TEST_SHARDS copies) each get a device of their own and keep their place.
+ *
+ * Options:
+ *   devices         requested number of emulators, ignored when there are several Android capabilities
+ *   avd             AVD name
+ *   snapshot        quick-boot snapshot to boot from, baked on first use for every APK, default 'wdio-farm'
+ *   apk             APK installed before baking the snapshot, default the template's appium:App
+ *   cpusPerDevice   host cores reserved per emulator, default 2
+ *   memoryPerDevice host RAM reserved per emulator in MB, default 3072
+ *   appiumPort      first Appium port, default 4740
+ *   appiumArgs      extra Appium server arguments in the Appium service's form, e.g. { usePlugins: 'macro' }
+ *   systemPort      first UiAutomator2 system port, default 8200
+ *   bootTimeout     ms to wait for boot_completed, default 180000
+ *   logPath         directory for emulator and Appium logs, default './'
+ */
+module.exports = class EmulatorFarmService {
+    constructor(options = {}) {
+        this.options = {
+            snapshot: 'wdio-farm',
+            cpusPerDevice: 2,
+            memoryPerDevice: 3072,
+            appiumPort: 4740,
+            systemPort: 8200,
+            bootTimeout: 180000,
+            logPath: './',
+            appiumArgs: {},
+            ...options,
+        };
+        this.processes = [];
+        this.devices = [];
+    }
+
+    async onPrepare(config, capabilities) {
+        try {
+            await this.startFarm(config, capabilities);
+        } catch (error) {
+            // A failed boot or Appium start would otherwise leave emulators and servers running after the launcher exits.
+            await this.onComplete();
+            throw error;
+        }
+    }
+
+    async startFarm(config, capabilities) {
+        const { avd } = this.options;
+        if (!avd) {
+            throw new Error('EmulatorFarmService needs an AVD name (EMULATOR_FARM_AVD)');
+        }
+        const templates = capabilities.filter((capability) => capability.platformName === 'Android');
+        if (templates.length === 0) {
+            throw new Error('EmulatorFarmService needs an Android capability to use as template');
+        }
+        const count = this.deviceCount(templates.length > 1 ? templates.length : this.options.devices || 1);
+        if (count < templates.length) {
+            throw new Error(`Emulator farm: ${templates.length} Android capabilities need as many devices, the host fits ${count}`);
+        }
+
+        // The snapshot has the app preinstalled, so each APK gets its own; a new build re-bakes instead of booting the old one.
+        const apk = this.options.apk || templates[0]['appium:App'] || templates[0]['appium:app'];
+        const hash = appHash(apk);
+        this.snapshot = hash ? `${this.options.snapshot}-${hash.slice(0, 12)}` : this.options.snapshot;
+        if (!this.hasSnapshot(avd, this.snapshot)) {
+            await this.bakeSnapshot(apk);
+        }
+
+        let consolePort = 5554;
+        let appiumPort = this.options.appiumPort;
+        let systemPort = this.options.systemPort;
+        for (let index = 0; index < count; index++) {
+            consolePort = await this.freeConsolePort(consolePort);
+            appiumPort = await freePort(appiumPort);
+            systemPort = await freePort(systemPort);
+            this.devices.push({ serial: `emulator-${consolePort}`, consolePort, appiumPort, systemPort });
+            consolePort += 2;
+            appiumPort++;
+            systemPort++;
+        }
+
+        await Promise.all(this.devices.map((device) => this.startDevice(device)));
+
+        const onDevice = (capability, device) => ({
+            ...capability,
+            port: device.appiumPort,
+            'appium:udid': device.serial,
+            'appium:systemPort': device.systemPort,
+        });
+        let next = 0;
+        const generated = capabilities.flatMap((capability) => {
+            if (capability.platformName !== 'Android') {
+                return [capability];
+            }
+            return templates.length === 1
+                ? this.devices.map((device) => onDevice(capability, device))
+                : [onDevice(capability, this.devices[next++])];
+        });
+        capabilities.splice(0, capabilities.length, ...generated);
+        config.maxInstances = Math.max(config.maxInstances || 1, capabilities.length);
+        process.env.EMULATOR_FARM_SERIALS = this.devices.map((device) => device.serial).join(',');
+        console.log(`Emulator farm: ${count} × ${avd} ready (${this.devices.map((device) => `${device.serial} → :${device.appiumPort}`).join(', ')})`);
+    }
+
+    async onComplete() {
+        await Promise.allSettled(this.devices.map((device) => adb(device.serial, ['emu', 'kill'])));
+        for (const child of this.processes) {
+            if (child.exitCode === null) {
+                child.kill();
+            }
+        }
+    }
+
+    /**
+     * Requested devices, capped so every emulator gets cpusPerDevice cores and memoryPerDevice MB of the host.
+     */
+    deviceCount(devices) {
+        const { cpusPerDevice, memoryPerDevice } = this.options;
+        const byCpu = Math.floor(os.cpus().length / cpusPerDevice);
+        const byMemory = Math.floor(os.totalmem() / 1024 / 1024 / memoryPerDevice);
+        const count = Math.max(1, Math.min(devices, byCpu, byMemory));
+        if (count < devices) {
+            console.warn(`Emulator farm: capped at ${count} devices (${os.cpus().length} cores, ${Math.round(os.totalmem() / 1024 ** 3)}GB RAM)`);
+        }
+        return count;
+    }
+
+    hasSnapshot(avd, snapshot) {
+        const avdHome = process.env.ANDROID_AVD_HOME || path.join(os.homedir(), '.android', 'avd');
+        return fs.existsSync(path.join(avdHome, `${avd}.avd`, 'snapshots', snapshot));
+    }
+
+    /**
+     * Boots one writable instance, installs the app and saves the quick-boot snapshot the farm boots from.
+     */
+    async bakeSnapshot(apk) {
+        const consolePort = await this.freeConsolePort(5554);
+        const device = { serial: `emulator-${consolePort}`, consolePort };
+        console.log(`Emulator farm: baking snapshot '${this.snapshot}' on ${device.serial}`);
+
+        this.launchEmulator(device, ['-no-snapshot-load']);
+        await this.waitForBoot(device.serial);
+        if (apk) {
+            await adb(device.serial, ['install', '-r', '-g', apk], { timeout: 300000 });
+        }
+        await adb(device.serial, ['emu', 'avd', 'snapshot', 'save', this.snapshot]);
+        await adb(device.serial, ['emu', 'kill']);
+    }
+
+    async startDevice(device) {
+        this.launchEmulator(device, ['-read-only', '-snapshot', this.snapshot, '-no-snapshot-save']);
+        await this.waitForBoot(device.serial);
+        await this.startAppium(device.appiumPort);
+    }
+
+    launchEmulator({ serial, consolePort }, extraArgs) {
+        const binary = process.env.ANDROID_HOME ? `${process.env.ANDROID_HOME}/emulator/emulator` : 'emulator';
+        const log = fs.openSync(path.join(this.options.logPath, `emulator-${consolePort}.log`), 'w');
+        const child = spawn(binary, [
+            '-avd', this.options.avd,
+            '-port', String(consolePort),
+            '-no-window', '-no-audio', '-no-boot-anim',
+            '-gpu', 'swiftshader_indirect',
+            ...extraArgs,
+        ], { stdio: ['ignore', log, log] });
+        child.on('exit', (code) => {
+            if (code) {
+                console.error(`Emulator ${serial} exited with code ${code}`);
+            }
+        });
+        this.processes.push(child);
+        return child;
+    }
+
+    async waitForBoot(serial) {
+        const deadline = Date.now() + this.options.bootTimeout;
+        await adb(serial, ['wait-for-device'], { timeout: this.options.bootTimeout });
+        while (Date.now() < deadline) {
+            const completed = await shell(serial, 'getprop', 'sys.boot_completed').catch(() => '');
+            if (completed.trim() === '1') {
+                return;
+            }
+            await new Promise((resolve) => setTimeout(resolve, BOOT_POLL_INTERVAL));
+        }
+        throw new Error(`Emulator ${serial} did not boot within ${this.options.bootTimeout}ms`);
+    }
+
+    async startAppium(port) {
+        const log = path.join(this.options.logPath, `appium-${port}.log`);
+        const extraArgs = Object.entries(this.options.appiumArgs).flatMap(([name, value]) => {
+            const flag = `--${name.replace(/[A-Z]/g, (letter) => `-${letter.toLowerCase()}`)}`;
+            return value === true ? [flag] : [flag, String(value)];
+        });
+        const child = spawn('appium', ['--port', String(port), '--log', log, '--log-timestamp', '--local-timezone', ...extraArgs],
+            { stdio: 'ignore' });
+        this.processes.push(child);
+
+        const deadline = Date.now() + 60000;
+        while (Date.now() < deadline) {
+            const ready = await fetch(`http://127.0.0.1:${port}/status`).then((response) => response.ok, () => false);
+            if (ready) {
+                return;
+            }
+            await new Promise((resolve) => setTimeout(resolve, 500));
+        }
+        throw new Error(`Appium on port ${port} did not start`);
+    }
+
+    /**
+     * Emulators take an even console port and the odd port after it for adb; the serial must not be attached yet.
+     */
+    async freeConsolePort(start) {
+        const output = await adb(undefined, ['devices']).catch(() => '');
+        const attached = output.split('\n').slice(1).map((line) => line.split('\t')[0]).filter(Boolean);
+        return freePort(start, 2, async (port) => !attached.includes(`emulator-${port}`) && canListen(port + 1));
+    }
+};
+
+/**
+ * First port at or after start (stepping by step) that can be bound on localhost and passes the filter.
+ */
+async function freePort(start, step = 1, accept = async () => true) {
+    for (let port = start; port < 65535; port += step) {
+        if (await accept(port) && await canListen(port)) {
+            return port;
+        }
+    }
+    throw new Error(`No free port from ${start}`);
+}
+
+function canListen(port) {
+    return new Promise((resolve) => {
+        const server = net.createServer();
+        server.once('error', () => resolve(false));
+        server.listen(port, '127.0.0.1', () => server.close(() => resolve(true)));
+    });
+}
@@ -0,0 +1,120 @@
+const fs = require('fs');
+const path = require('path');
+const { readAppiumLog, sessionStartupPhases } = require('../utilities/appiumLog');
+
+/**
+ * Breaks session creation into phases (adb device discovery, app install, UiAutomator2 server install and boot,
+ * app launch) from the Appium server logs, so a slow start can be blamed on the right layer. beforeSession and
+ * before bracket session creation as the client sees it; after the session the worker finds it in the Appium logs
+ * and appends the breakdown to the history file. At the end of the run the launcher compares each phase with the
+ * median of earlier runs and flags regressions.
+ *
+ * Appium must write timestamps (--log-timestamp --local-timezone) for the logs to be parsed.
+ *
+ * Options:
+ *   logDir       directory with the Appium logs (appium-<port>.log, wdio-appium.log), default './'
+ *   historyFile  per-session history, one JSON object per line, default './.perf/session-startup.jsonl'
+ *   baselineRuns earlier runs the trend is compared with, default 10
+ *   threshold    ratio over the baseline median a phase must exceed to be flagged, default 1.5
+ *   minDelta     milliseconds a phase must exceed its baseline by to be flagged, default 2000
+ */
+module.exports = class SessionStartupService {
+    constructor(options = {}) {
+        this.logDir = path.resolve(options.logDir || './');
+        this.historyFile = path.resolve(options.historyFile || './.perf/session-startup.jsonl');
+        this.baselineRuns = options.baselineRuns || 10;
+        this.threshold = options.threshold || 1.5;
+        this.minDelta = options.minDelta ?? 2000;
+    }
+
+    onPrepare() {
+        process.env.SESSION_STARTUP_RUN = process.env.SESSION_STARTUP_RUN || new Date().toISOString();
+    }
+
+    beforeSession() {
+        this.requestedAt = Date.now();
+    }
+
+    before(capabilities, specs, browser) {
+        this.session = {
+            sessionId: browser.sessionId,
+            platform: capabilities.platformName,
+            device: capabilities['appium:udid'] || capabilities['appium:deviceName'],
+            client: Date.now() - this.requestedAt,
+        };
+    }
+
+    after() {
+        if (!this.session) {
+            return;
+        }
+        const breakdown = this.findInLogs(this.session.sessionId);
+        const record = {
+            run: process.env.SESSION_STARTUP_RUN,
+            recordedAt: new Date().toISOString(),
+            ...this.session,
+            total: breakdown ? breakdown.total : null,
+            phases: breakdown ? breakdown.phases : {},
+        };
+        fs.mkdirSync(path.dirname(this.historyFile), { recursive: true });
+        fs.appendFileSync(this.historyFile, `${JSON.stringify(record)}\n`);
+
+        if (!breakdown) {
+            console.log(`Session startup: ${record.client}ms, session ${record.sessionId} not found in the Appium logs in ${this.logDir}`);
+            return;
+        }
+        const phases = Object.entries(breakdown.phases).map(([phase, duration]) => `${phase} ${duration}ms`).join(', ');
+        console.log(`Session startup: ${breakdown.total}ms on the server (${record.client}ms in the client): ${phases}`);
+    }
+
+    findInLogs(sessionId) {
+        if (!fs.existsSync(this.logDir)) {
+            return null;
+        }
+        const logs = fs.readdirSync(this.logDir).filter((file) => /^(wdio-)?appium.*\.log$/.test(file));
+        for (const file of logs) {
+            const full = path.join(this.logDir, file);
+            if (fs.readFileSync(full, 'utf8').includes(sessionId)) {
+                return sessionStartupPhases(readAppiumLog(full), sessionId);
+            }
+        }
+        return null;
+    }
+
+    onComplete() {
+        const run = process.env.SESSION_STARTUP_RUN;
+        const history = this.read();
+        const current = history.filter((record) => record.run === run && record.total !== null);
+        if (current.length === 0) {
+            return;
+        }
+        const earlierRuns = [...new Set(history.filter((record) => record.run < run).map((record) => record.run))]
+            .sort()
+            .slice(-this.baselineRuns);
+        const baseline = history.filter((record) => earlierRuns.includes(record.run) && record.total !== null);
+
+        console.log(`Session startup over ${current.length} sessions (baseline: median of ${earlierRuns.length} earlier runs):`);
+        const phases = [...new Set([...current, ...baseline].flatMap((record) => Object.keys(record.phases)))];
+        for (const phase of ['total', ...phases]) {
+            const valueOf = (record) => (phase === 'total' ? record.total : record.phases[phase] || 0);
+            const mean = Math.round(current.map(valueOf).reduce((sum, value) => sum + value, 0) / current.length);
+            const reference = baseline.length ? median(baseline.map(valueOf)) : null;
+            const regressed = reference !== null && mean > reference * this.threshold && mean - reference > this.minDelta;
+            const trend = reference === null ? '' : `, baseline ${reference}ms`;
+            console.log(`  ${regressed ? 'REGRESSION ' : ''}${phase}: ${mean}ms${trend}`);
+        }
+    }
+
+    read() {
+        if (!fs.existsSync(this.historyFile)) {
+            return [];
+        }
+        return fs.readFileSync(this.historyFile, 'utf8').split('\n').filter(Boolean).map((line) => JSON.parse(line));
+    }
+};
+
+function median(values) {
+    const sorted = [...values].sort((a, b) => a - b);
+    const middle = Math.floor(sorted.length / 2);
+    return sorted.length % 2 ? sorted[middle] : Math.round((sorted[middle - 1] + sorted[middle]) / 2);
+}
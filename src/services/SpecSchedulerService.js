@@ -0,0 +1,210 @@
+const fs = require('fs');
+const path = require('path');
+const { fileURLToPath } = require('url');
+const { expandSpecs, specBaseDir } = require('../utilities/specFiles');
+
+const HISTORY_RUNS = 5;
+
+/**
+ * Orders spec files longest-processing-time-first from a local duration history, so the slowest files start
+ * first and the wdio launcher's idle workers pick up the short ones at the end. Keeps a history per spec file
+ * (launcher side, from worker start/end) and per test (worker side, from afterTest), and prints the predicted
+ * versus actual makespan at the end of the run. Each capability is predicted on its own workers (its maxInstances,
+ * within the config's maxInstances), and the run as the launcher shares the config's workers between them. The spec
+ * files workers actually received are compared with the planned order at the end of the run, so a launcher that
+ * ignores the reordered capability.specs shows up. Not registered when replaying a recording.
+ *
+ * Options:
+ *   historyFile  duration history, default './.perf/spec-history.json'
+ */
+module.exports = class SpecSchedulerService {
+    constructor(options = {}) {
+        this.historyFile = path.resolve(options.historyFile || './.perf/spec-history.json');
+        this.workerDir = path.join(path.dirname(this.historyFile), 'spec-history');
+        this.started = new Map();
+        this.planned = [];
+        this.received = [];
+        this.fileRuns = {};
+        this.tests = [];
+    }
+
+    onPrepare(config, capabilities) {
+        fs.rmSync(this.workerDir, { recursive: true, force: true });
+        if (config.spec && config.spec.length) {
+            console.log('Spec scheduler: --spec given, keeping the requested order');
+            return;
+        }
+
+        const history = this.readHistory();
+        const baseDir = specBaseDir(config);
+        const maxInstances = config.maxInstances || 1;
+        const queues = [];
+        for (const [index, capability] of [].concat(capabilities).entries()) {
+            if (!capability.specs) {
+                continue;
+            }
+            const files = expandSpecs(capability.specs, baseDir).map((file) => ({ file, estimate: this.estimate(history, file) }));
+            const known = files.filter((job) => job.estimate !== undefined).map((job) => job.estimate);
+            // Files without history go first: assuming they are long costs little, guessing short can leave a tail.
+            const fallback = known.length ? Math.max(...known) : 0;
+            files.forEach((job) => { job.estimate ??= fallback; });
+            files.sort((a, b) => b.estimate - a.estimate);
+            capability.specs = files.map((job) => job.file);
+            this.planned[index] = { name: capabilityName(capability), files: capability.specs.map(relative) };
+            const workers = Math.min(capability['wdio:maxInstances'] ?? capability.maxInstances
+                ?? config.maxInstancesPerCapability ?? maxInstances, maxInstances);
+            queues.push({ name: capabilityName(capability), durations: files.map((job) => job.estimate), workers });
+        }
+
+        this.runStart = Date.now();
+        const known = queues.some((queue) => queue.durations.some((duration) => duration > 0));
+        for (const queue of queues) {
+            const prediction = known ? makespan([queue], queue.workers) : undefined;
+            console.log(`Spec scheduler: ${queue.name}: ${queue.durations.length} spec files longest-first on ${queue.workers} `
+                + `workers, predicted ${seconds(prediction)}`);
+        }
+        if (known) {
+            this.prediction = makespan(queues, maxInstances);
+        }
+        console.log(`Spec scheduler: predicted makespan of the run ${seconds(this.prediction)}`);
+    }
+
+    onWorkerStart(cid, capabilities, specs) {
+        this.started.set(cid, { start: Date.now(), specs });
+        const index = Number(cid.split('-')[0]);
+        (this.received[index] ||= []).push(...[].concat(specs).flat().map(relative));
+    }
+
+    onWorkerEnd(cid, exitCode, specs) {
+        const worker = this.started.get(cid);
+        if (!worker) {
+            return;
+        }
+        this.lastEnd = Date.now();
+        // A worker runs one spec file (or one spec group); groups are split evenly across their files.
+        const files = [].concat(worker.specs).flat().map(relative);
+        const share = (this.lastEnd - worker.start) / files.length;
+        files.forEach((file) => (this.fileRuns[file] = this.fileRuns[file] || []).push(Math.round(share)));
+    }
+
+    afterTest(test, context, { duration }) {
+        this.tests.push({ file: relative(test.file), title: test.fullTitle, duration });
+    }
+
+    after() {
+        if (this.tests.length === 0) {
+            return;
+        }
+        fs.mkdirSync(this.workerDir, { recursive: true });
+        const file = path.join(this.workerDir, `tests-${process.env.WDIO_WORKER_ID || process.pid}.json`);
+        fs.writeFileSync(file, JSON.stringify(this.tests));
+    }
+
+    onComplete() {
+        const history = this.readHistory();
+        for (const [file, runs] of Object.entries(this.fileRuns)) {
+            history.files[file] = [...(history.files[file] || []), ...runs].slice(-HISTORY_RUNS);
+        }
+        if (fs.existsSync(this.workerDir)) {
+            for (const file of fs.readdirSync(this.workerDir)) {
+                for (const test of JSON.parse(fs.readFileSync(path.join(this.workerDir, file), 'utf8'))) {
+                    const key = `${test.file}::${test.title}`;
+                    history.tests[key] = [...(history.tests[key] || []), test.duration].slice(-HISTORY_RUNS);
+                }
+            }
+            fs.rmSync(this.workerDir, { recursive: true, force: true });
+        }
+        fs.mkdirSync(path.dirname(this.historyFile), { recursive: true });
+        fs.writeFileSync(this.historyFile, JSON.stringify(history, null, 2));
+
+        if (this.lastEnd) {
+            console.log(`Spec scheduler: predicted makespan ${seconds(this.prediction)}, actual ${seconds(this.lastEnd - this.runStart)}`);
+        }
+        this.reportOrder();
+    }
+
+    /**
+     * Logs, per capability, whether workers were started on the spec files in the planned order.
+     */
+    reportOrder() {
+        this.planned.forEach((plan, index) => {
+            const received = this.received[index] || [];
+            if (received.length === 0) {
+                return;
+            }
+            const expected = plan.files.filter((file) => received.includes(file));
+            const mismatch = received.findIndex((file, position) => file !== expected[position]);
+            console.log(mismatch === -1
+                ? `Spec scheduler: ${plan.name}: workers received ${received.length} spec files in the planned order`
+                : `Spec scheduler: ${plan.name}: workers received ${received[mismatch]} as spec file ${mismatch + 1}, `
+                    + `planned ${expected[mismatch]}`);
+        });
+    }
+
+    readHistory() {
+        if (!fs.existsSync(this.historyFile)) {
+            return { files: {}, tests: {} };
+        }
+        return { files: {}, tests: {}, ...JSON.parse(fs.readFileSync(this.historyFile, 'utf8')) };
+    }
+
+    /**
+     * Expected duration of a spec file: mean of its recent runs, else the sum of its tests' recent means.
+     */
+    estimate(history, file) {
+        const key = relative(file);
+        if (history.files[key]) {
+            return mean(history.files[key]);
+        }
+        const tests = Object.entries(history.tests).filter(([testKey]) => testKey.startsWith(`${key}::`));
+        return tests.length ? tests.reduce((sum, [, runs]) => sum + mean(runs), 0) : undefined;
+    }
+};
+
+function relative(file) {
+    const filePath = file.startsWith('file:') ? fileURLToPath(file) : file;
+    return path.relative(process.cwd(), filePath).split(path.sep).join('/');
+}
+
+function mean(values) {
+    return values.reduce((sum, value) => sum + value, 0) / values.length;
+}
+
+function capabilityName(capability) {
+    return [capability.platformName, capability['appium:udid'] || capability['appium:deviceName']].filter(Boolean).join(' ');
+}
+
+/**
+ * Simulates the launcher handing out spec files: whenever a worker frees up, capabilities are visited in order and
+ * each starts its next file while it is below its own worker count and the run is below maxInstances.
+ * @param {Object[]} queues - { durations, workers } per capability, durations in hand-out order.
+ * @param {number} maxInstances - workers of the whole run.
+ * @returns {number} time until the last file ends.
+ */
+function makespan(queues, maxInstances) {
+    const pending = queues.map((queue) => ({ durations: [...queue.durations], workers: Math.max(1, queue.workers), running: 0 }));
+    const running = [];
+    let now = 0;
+    for (;;) {
+        for (const queue of pending) {
+            while (queue.durations.length && queue.running < queue.workers && running.length < Math.max(1, maxInstances)) {
+                running.push({ end: now + queue.durations.shift(), queue });
+                queue.running++;
+            }
+        }
+        if (running.length === 0) {
+            return now;
+        }
+        running.sort((a, b) => a.end - b.end);
+        const next = running.shift();
+        next.queue.running--;
+        now = next.end;
+    }
+}
+
+function seconds(ms) {
+    if (ms === undefined) {
+        return 'unknown (no history yet)';
+    }
+    return `${(ms / 1000).toFixed(1)}s`;
+}
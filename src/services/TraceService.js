@@ -0,0 +1,85 @@
+const fs = require('fs');
+const path = require('path');
+const PageObjectTracer = require('../utilities/instrumentation/PageObjectTracer');
+const CommandTimer = require('../utilities/instrumentation/CommandTimer');
+const Timeline = require('../utilities/instrumentation/Timeline');
+
+/**
+ * Writes one Chrome Trace Event / Perfetto JSON file per spec file with nested spans for describe blocks,
+ * hooks, tests, page-object methods and WebDriver commands (timed by CommandTimer, see CommandTimingService),
+ * plus idle spans for gaps between commands.
+ *
+ * Options:
+ *   outputDir   directory for trace files, default './reports/traces'
+ *   idleGapMs   shortest gap between commands recorded as idle, default 20
+ */
+module.exports = class TraceService {
+    constructor(options = {}) {
+        this.outputDir = path.resolve(options.outputDir || './reports/traces');
+        this.idleGapMs = options.idleGapMs ?? 20;
+        this.suites = [];
+        this.lastCommandEnd = null;
+    }
+
+    before() {
+        PageObjectTracer.subscribe((event, frames, start, end) => {
+            if (event === 'exit') {
+                Timeline.add(PageObjectTracer.format(frames.slice(-1)), 'page-object', start, end,
+                    { path: PageObjectTracer.format(frames) });
+            }
+        });
+        CommandTimer.subscribe((event, command) => (event === 'start' ? this.commandStarted(command) : this.commandEnded(command)));
+    }
+
+    beforeSuite(suite) {
+        this.suites.push({ title: suite.title, start: Date.now() });
+    }
+
+    afterSuite(suite) {
+        const entry = this.suites.pop();
+        if (entry) {
+            Timeline.add(entry.title, 'suite', entry.start, Date.now(), { file: suite.file });
+        }
+    }
+
+    beforeHook(test, context, hookName) {
+        this.hookStart = Date.now();
+    }
+
+    afterHook(test, context, result, hookName) {
+        if (this.hookStart) {
+            Timeline.add(hookName || 'hook', 'hook', this.hookStart, Date.now(), { test: test && test.title });
+            this.hookStart = null;
+        }
+    }
+
+    beforeTest(test) {
+        this.testStart = Date.now();
+        this.lastCommandEnd = null;
+    }
+
+    afterTest(test, context, { passed }) {
+        Timeline.add(test.title, 'test', this.testStart, Date.now(), { passed });
+    }
+
+    commandStarted({ nested, start }) {
+        if (!nested && this.lastCommandEnd !== null && start - this.lastCommandEnd >= this.idleGapMs) {
+            Timeline.add('idle', 'idle', this.lastCommandEnd, start, {}, 'idle');
+        }
+    }
+
+    commandEnded({ commandName, start, end, path, error }) {
+        Timeline.add(commandName, 'command', start, end,
+            { pageObject: path, ...(error ? { error: error.message } : {}) }, 'commands');
+        if (CommandTimer.idle()) {
+            this.lastCommandEnd = end;
+        }
+    }
+
+    after(result, capabilities, specs) {
+        const spec = path.basename((specs && specs[0]) || 'spec', '.js');
+        fs.mkdirSync(this.outputDir, { recursive: true });
+        const file = path.join(this.outputDir, `${spec}-${process.env.WDIO_WORKER_ID || process.pid}.json`);
+        fs.writeFileSync(file, JSON.stringify(Timeline.flush(spec)));
+    }
+};
@@ -0,0 +1,80 @@
+const path = require('path');
+const { execFileSync } = require('child_process');
+const PageObjectTracer = require('../utilities/instrumentation/PageObjectTracer');
+const CommandTimer = require('../utilities/instrumentation/CommandTimer');
+const { appHash, sessionArtifact } = require('../utilities/appArtifact');
+const { appendTrends } = require('../utilities/trendStore');
+const { summarize } = require('../utilities/stats');
+
+/**
+ * Appends the timings of every run to a local trend store so shifts across builds can be found later with
+ * 'npm run trends'. Each worker summarizes its test, page-object step and WebDriver command durations and appends
+ * one row per name, tagged with the run, the git commit, the app build hash, the platform and the device.
+ *
+ * Options:
+ *   storeFile  trend store, one JSON row per line, default './.perf/trends.ndjson'
+ */
+module.exports = class TrendService {
+    constructor(options = {}) {
+        this.storeFile = path.resolve(options.storeFile || './.perf/trends.ndjson');
+        this.durations = { test: {}, step: {}, command: {} };
+    }
+
+    onPrepare() {
+        process.env.TREND_RUN = process.env.TREND_RUN || new Date().toISOString();
+        if (!process.env.TREND_GIT_SHA) {
+            try {
+                process.env.TREND_GIT_SHA = execFileSync('git', ['rev-parse', '--short', 'HEAD'], { encoding: 'utf8' }).trim();
+            } catch (error) {
+                process.env.TREND_GIT_SHA = 'unknown';
+            }
+        }
+    }
+
+    before(capabilities) {
+        this.platform = capabilities.platformName;
+        this.device = capabilities['appium:udid'] || capabilities['appium:deviceName'];
+        PageObjectTracer.subscribe((event, frames, start, end) => {
+            if (event === 'exit') {
+                this.record('step', PageObjectTracer.format(frames.slice(-1)), end - start);
+            }
+        });
+        CommandTimer.subscribe((event, command) => {
+            if (event === 'end') {
+                this.record('command', command.commandName, command.duration);
+            }
+        });
+    }
+
+    afterTest(test, context, { duration }) {
+        this.record('test', test.fullTitle || test.title, duration);
+    }
+
+    record(kind, name, duration) {
+        (this.durations[kind][name] = this.durations[kind][name] || []).push(duration);
+    }
+
+    after() {
+        const hash = appHash(sessionArtifact());
+        if (!hash) {
+            // Runs of unknown builds would read as one build and hide or invent shifts between them.
+            console.warn('TrendService: app build hash unknown, timings not added to the trend store');
+            return;
+        }
+        const build = hash.slice(0, 12);
+        const tags = {
+            run: process.env.TREND_RUN || new Date().toISOString(),
+            date: new Date().toISOString(),
+            git: process.env.TREND_GIT_SHA || 'unknown',
+            build,
+            platform: this.platform,
+            device: this.device,
+        };
+        const rows = Object.entries(this.durations).flatMap(([kind, byName]) => Object.entries(byName)
+            .map(([name, durations]) => {
+                const { count, mean, p50, p95, max } = summarize(durations);
+                return { ...tags, kind, name, count, mean, p50, p95, max };
+            }));
+        appendTrends(this.storeFile, rows);
+    }
+};
@@ -0,0 +1,297 @@
+const http = require('http');
+const { readBody, parseJson } = require('../webdriver-recorder/RecordingProxy');
+const { summarize } = require('../../utilities/stats');
+
+const W3C_CAPABILITIES = [
+    'platformName', 'browserName', 'browserVersion', 'acceptInsecureCerts', 'pageLoadStrategy', 'proxy',
+    'setWindowRect', 'timeouts', 'strictFileInteractability', 'unhandledPromptBehavior', 'webSocketUrl',
+];
+
+/**
+ * Capabilities as sent to the server: W3C names and vendor-prefixed ones, without wdio-only keys such as specs or port.
+ */
+function w3cCapabilities(capabilities) {
+    return Object.fromEntries(Object.entries(capabilities)
+        .filter(([name]) => name.includes(':') || W3C_CAPABILITIES.includes(name)));
+}
+
+/**
+ * Sessions are interchangeable when they drive the same app with the same automation on the same platform.
+ */
+function poolKey(capabilities) {
+    const caps = capabilities || {};
+    return [
+        caps.platformName,
+        caps['appium:automationName'],
+        caps['appium:appPackage'] || caps['appium:bundleId'] || caps['appium:App'] || caps['appium:app'],
+    ].map((part) => String(part || '').toLowerCase()).join('|');
+}
+
+/**
+ * True when a session created for one capability set can serve a request for the other: same platform, automation,
+ * app and device name (the udid is matched with the device slot). Everything else only changes how the session was
+ * started, e.g. ports, or noReset and a removed appium:app after AppProvisioningService found the app installed.
+ */
+function sameIdentity(a, b) {
+    const identity = (capabilities) => `${poolKey(capabilities)}|${String(capabilities?.['appium:deviceName'] || '').toLowerCase()}`;
+    return identity(a) === identity(b);
+}
+
+/**
+ * WebDriver front for Appium that keeps a ready session per device. When a worker asks for a new session it gets
+ * a session that was created in the background (while the previous spec was still running), and ending a
+ * session immediately starts warming the next one on that device. Requests wait in a queue while every device is
+ * leased. All other commands are forwarded to Appium.
+ */
+class SessionBroker {
+    /**
+     * @param {Object} options
+     * @param {number} options.port - port WebdriverIO connects to.
+     * @param {string} [options.targetHost='127.0.0.1'] - Appium host.
+     * @param {number} options.targetPort - Appium port.
+     * @param {Array<Object>} options.devices - device slots, e.g. [{ udid: 'emulator-5554', systemPort: 8200 }]; without
+     *   devices there is one slot per platform/app, on whatever device Appium picks.
+     * @param {number} [options.leaseTimeout=300000] - ms without commands after which a leased session is taken back,
+     *   for workers that died without ending their session.
+     */
+    constructor({ port, targetHost = '127.0.0.1', targetPort, devices, leaseTimeout = 300000 }) {
+        this.port = port;
+        this.targetHost = targetHost;
+        this.targetPort = targetPort;
+        this.leaseTimeout = leaseTimeout;
+        this.defaultDevice = devices.length === 0;
+        this.slots = devices.map((device) => this.slot(device));
+        this.queue = [];
+        this.leases = [];
+        this.server = http.createServer((request, response) => this.handle(request, response));
+    }
+
+    slot(device) {
+        return { device, key: null, template: null, warm: null, leased: null, lastUsed: 0 };
+    }
+
+    start() {
+        this.reaper = setInterval(() => this.reclaimIdleLeases(), Math.min(this.leaseTimeout / 4, 30000));
+        this.reaper.unref();
+        return new Promise((resolve) => this.server.listen(this.port, '127.0.0.1', resolve));
+    }
+
+    async stop() {
+        clearInterval(this.reaper);
+        for (const { response } of this.queue.splice(0)) {
+            this.reply(response, 500, { value: { error: 'session not created', message: 'Session broker: stopped' } });
+        }
+        await new Promise((resolve) => this.server.close(resolve));
+        await Promise.allSettled(this.slots.map(async (slot) => {
+            const warm = await slot.warm?.catch(() => null);
+            if (warm) {
+                await this.appium('DELETE', `/session/${warm.sessionId}`);
+            }
+        }));
+    }
+
+    /**
+     * Starts creating sessions for the given capabilities on every idle device.
+     * @param {Object[]} capabilities - capabilities from the config.
+     * @returns {void}
+     */
+    prewarm(capabilities) {
+        if (this.defaultDevice) {
+            for (const capability of capabilities) {
+                const key = poolKey(capability);
+                if (!this.slots.some((slot) => slot.key === key)) {
+                    const slot = this.slot({});
+                    this.slots.push(slot);
+                    this.warm(slot, w3cCapabilities(capability));
+                }
+            }
+            return;
+        }
+        const idle = this.slots.filter((slot) => !slot.warm && !slot.leased);
+        capabilities.forEach((capability, index) => {
+            const slot = idle[index % idle.length];
+            if (slot && !slot.warm) {
+                this.warm(slot, w3cCapabilities(capability));
+            }
+        });
+    }
+
+    warm(slot, capabilities) {
+        const { udid, systemPort } = slot.device;
+        const requested = {
+            ...(udid ? { 'appium:udid': udid } : {}),
+            ...(systemPort ? { 'appium:systemPort': systemPort } : {}),
+            ...capabilities,
+            // A warm session may wait for a worker longer than the default 60s command timeout.
+            'appium:newCommandTimeout': Math.max(capabilities['appium:newCommandTimeout'] || 0, 600),
+        };
+        slot.key = poolKey(capabilities);
+        slot.template = capabilities;
+        const started = Date.now();
+        const warm = this.appium('POST', '/session', { capabilities: { alwaysMatch: requested, firstMatch: [{}] } })
+            .then(({ status, body }) => {
+                const sessionId = body?.value?.sessionId;
+                if (status !== 200 || !sessionId) {
+                    throw new Error(body?.value?.message || `session creation failed with HTTP ${status}`);
+                }
+                return { sessionId, body, started, ready: Date.now() };
+            });
+        warm.catch((error) => {
+            console.warn(`Session broker: warming on ${udid || 'default device'} failed: ${error.message}`);
+            if (slot.warm === warm) {
+                slot.warm = null;
+            }
+        });
+        slot.warm = warm;
+    }
+
+    async handle(request, response) {
+        const body = await readBody(request);
+        const deleted = request.method === 'DELETE' && request.url.match(/\/session\/([^/]+)\/?$/);
+        if (request.method === 'POST' && /\/session\/?$/.test(request.url)) {
+            return this.lease(parseJson(body), response, Date.now());
+        }
+        const sessionId = (request.url.match(/\/session\/([^/?]+)/) || [])[1];
+        const slot = sessionId && this.slots.find((candidate) => candidate.leased === sessionId);
+        if (slot) {
+            slot.lastUsed = Date.now();
+        }
+        await this.forward(request, body, response);
+        if (deleted && slot) {
+            this.release(slot);
+        }
+    }
+
+    /**
+     * Hands out a warm session matching the requested capabilities, waiting for one that is still starting;
+     * falls back to creating a session on a free device when nothing matches, and queues the request while every
+     * device is leased.
+     */
+    async lease(requestBody, response, requestedAt) {
+        const requested = w3cCapabilities(requestBody?.capabilities?.alwaysMatch || {});
+        const udid = requested['appium:udid'];
+        const key = poolKey(requested);
+        const fits = (slot) => !slot.leased && (!udid || slot.device.udid === udid) && (!this.defaultDevice || slot.key === key);
+
+        if (this.defaultDevice && !this.slots.some((slot) => slot.key === key)) {
+            const slot = this.slot({});
+            slot.key = key;
+            this.slots.push(slot);
+        }
+        const slot = this.slots.find((candidate) => fits(candidate) && candidate.warm && candidate.key === key)
+            || this.slots.find((candidate) => fits(candidate) && !candidate.warm)
+            || this.slots.find(fits);
+        if (!slot) {
+            this.queue.push({ requestBody, response, requestedAt });
+            return;
+        }
+        slot.leased = 'pending';
+
+        // A warm session for another app or device is ended and replaced by one for the requested capabilities.
+        if (slot.warm && (slot.key !== key || !sameIdentity(slot.template, requested))) {
+            await slot.warm.then(({ sessionId }) => this.appium('DELETE', `/session/${sessionId}`), () => {});
+            slot.warm = null;
+        }
+        if (!slot.warm) {
+            this.warm(slot, requested);
+        }
+
+        let warm;
+        try {
+            warm = await slot.warm;
+        } catch (error) {
+            slot.warm = null;
+            this.release(slot, { rewarm: false });
+            return this.reply(response, 500, { value: { error: 'session not created', message: error.message } });
+        }
+        slot.warm = null;
+        slot.leased = warm.sessionId;
+        slot.lastUsed = Date.now();
+
+        const creation = warm.ready - warm.started;
+        const waited = Math.max(0, Date.now() - requestedAt);
+        this.leases.push({ device: slot.device.udid || 'default', key, creation, waited, hidden: Math.max(0, creation - waited) });
+        this.reply(response, 200, warm.body);
+    }
+
+    /**
+     * Frees a device, warms its next session and serves queued requests.
+     */
+    release(slot, { rewarm = true } = {}) {
+        slot.leased = null;
+        if (rewarm && slot.template) {
+            this.warm(slot, slot.template);
+        }
+        for (const { requestBody, response, requestedAt } of this.queue.splice(0)) {
+            this.lease(requestBody, response, requestedAt);
+        }
+    }
+
+    /**
+     * Ends sessions whose worker stopped sending commands without deleting them, so their device is not lost.
+     */
+    reclaimIdleLeases() {
+        const now = Date.now();
+        for (const slot of this.slots) {
+            if (slot.leased && slot.leased !== 'pending' && now - slot.lastUsed > this.leaseTimeout) {
+                console.warn(`Session broker: session ${slot.leased} idle for ${Math.round((now - slot.lastUsed) / 1000)}s, ending it`);
+                this.appium('DELETE', `/session/${slot.leased}`).catch(() => {});
+                this.release(slot);
+            }
+        }
+    }
+
+    forward(request, body, response) {
+        return new Promise((resolve) => {
+            const upstream = http.request({
+                host: this.targetHost,
+                port: this.targetPort,
+                method: request.method,
+                path: request.url,
+                headers: { ...request.headers, host: `${this.targetHost}:${this.targetPort}` },
+            }, async (upstreamResponse) => {
+                const responseBody = await readBody(upstreamResponse);
+                response.writeHead(upstreamResponse.statusCode, upstreamResponse.headers);
+                response.end(responseBody);
+                resolve();
+            });
+            upstream.on('error', (error) => {
+                this.reply(response, 502, { value: { error: 'unknown error', message: `Session broker: ${error.message}` } });
+                resolve();
+            });
+            upstream.end(body);
+        });
+    }
+
+    async appium(method, path, body) {
+        const response = await fetch(`http://${this.targetHost}:${this.targetPort}${path}`, {
+            method,
+            headers: { 'Content-Type': 'application/json' },
+            body: body ? JSON.stringify(body) : undefined,
+        });
+        return { status: response.status, body: parseJson(await response.text()) };
+    }
+
+    reply(response, status, body) {
+        response.writeHead(status, { 'content-type': 'application/json; charset=utf-8' });
+        response.end(JSON.stringify(body));
+    }
+
+    /**
+     * Session creation time hidden from workers: for each lease, creation time minus the time the worker waited.
+     * @returns {Object} lease count, total and per-lease summaries of creation, wait and hidden time.
+     */
+    metrics() {
+        const pick = (field) => this.leases.map((lease) => lease[field]);
+        return {
+            leases: this.leases.length,
+            hiddenTotal: pick('hidden').reduce((sum, value) => sum + value, 0),
+            creation: summarize(pick('creation')),
+            waited: summarize(pick('waited')),
+            hidden: summarize(pick('hidden')),
+            byLease: this.leases,
+        };
+    }
+}
+
+module.exports = { SessionBroker, w3cCapabilities, poolKey };
@@ -0,0 +1,48 @@
+const fs = require('fs');
+const path = require('path');
+const { SessionBroker } = require('./SessionBroker');
+
+/**
+ * Launcher service running the session broker: WebdriverIO connects to the broker, which hands out sessions
+ * created ahead of time and warms the next one on a device as soon as the previous session ends.
+ *
+ * Options:
+ *   port        port WebdriverIO connects to (the config's port)
+ *   targetPort  Appium port
+ *   devices     adb serials / simulator UDIDs to spread sessions over; empty uses the device Appium picks
+ *   systemPort  first UiAutomator2 system port handed to the devices, default 8200
+ *   leaseTimeout ms without commands after which a leased session is ended and its device freed, default 300000
+ *   outputDir   directory for session-broker.json, default './reports'
+ */
+module.exports = class SessionBrokerService {
+    constructor(options) {
+        this.options = { systemPort: 8200, outputDir: './reports', devices: [], ...options };
+    }
+
+    async onPrepare(config, capabilities) {
+        const { port, targetPort, devices, systemPort, leaseTimeout } = this.options;
+        this.broker = new SessionBroker({
+            port,
+            targetPort,
+            leaseTimeout,
+            devices: devices.map((udid, index) => ({ udid, systemPort: systemPort + index })),
+        });
+        await this.broker.start();
+        this.broker.prewarm([].concat(capabilities).filter((capability) => !capability.port));
+        console.log(`Session broker listening on ${port}, warming sessions on ${devices.length || 'the default'} device(s)`);
+    }
+
+    async onComplete() {
+        if (!this.broker) {
+            return;
+        }
+        await this.broker.stop();
+        const metrics = this.broker.metrics();
+        fs.mkdirSync(this.options.outputDir, { recursive: true });
+        fs.writeFileSync(path.join(this.options.outputDir, 'session-broker.json'), JSON.stringify(metrics, null, 2));
+        if (metrics.leases) {
+            console.log(`Session broker: ${metrics.leases} sessions, ${Math.round(metrics.hiddenTotal / 1000)}s of session creation hidden `
+                + `(creation p50 ${metrics.creation.p50}ms, workers waited p50 ${metrics.waited.p50}ms)`);
+        }
+    }
+};
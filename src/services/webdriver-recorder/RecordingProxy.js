@@ -0,0 +1,117 @@
+const fs = require('fs');
+const http = require('http');
+const path = require('path');
+
+/**
+ * HTTP proxy placed between WebdriverIO and Appium that stores every WebDriver request and response,
+ * grouped per session, as JSON files in the recording directory.
+ */
+class RecordingProxy {
+    /**
+     * @param {Object} options
+     * @param {number} options.port - port the proxy listens on (the port WebdriverIO connects to).
+     * @param {string} [options.targetHost='127.0.0.1'] - Appium host.
+     * @param {number} options.targetPort - Appium port.
+     * @param {string} options.dir - directory the recording is written to.
+     */
+    constructor({ port, targetHost = '127.0.0.1', targetPort, dir }) {
+        this.port = port;
+        this.targetHost = targetHost;
+        this.targetPort = targetPort;
+        this.dir = dir;
+        this.sessions = new Map();
+        this.server = http.createServer((request, response) => this.handle(request, response));
+    }
+
+    start() {
+        fs.mkdirSync(this.dir, { recursive: true });
+        return new Promise((resolve) => this.server.listen(this.port, '127.0.0.1', resolve));
+    }
+
+    async stop() {
+        await new Promise((resolve) => this.server.close(resolve));
+        for (const sessionId of this.sessions.keys()) {
+            this.flush(sessionId);
+        }
+    }
+
+    async handle(request, response) {
+        const body = await readBody(request);
+        const start = Date.now();
+        const sessionId = (request.url.match(/\/session\/([^/]+)/) || [])[1];
+        const entry = { method: request.method, path: request.url, body: parseJson(body), start };
+        if (sessionId) {
+            this.session(sessionId).push(entry);
+        }
+
+        const upstream = http.request({
+            host: this.targetHost,
+            port: this.targetPort,
+            method: request.method,
+            path: request.url,
+            headers: { ...request.headers, host: `${this.targetHost}:${this.targetPort}` },
+        }, async (upstreamResponse) => {
+            const responseBody = await readBody(upstreamResponse);
+            entry.status = upstreamResponse.statusCode;
+            entry.response = parseJson(responseBody);
+            entry.duration = Date.now() - start;
+
+            if (!sessionId && request.method === 'POST' && /\/session\/?$/.test(request.url)) {
+                const createdId = entry.response?.value?.sessionId ?? entry.response?.sessionId;
+                if (createdId) {
+                    this.session(createdId).unshift(entry);
+                }
+            }
+            if (sessionId && request.method === 'DELETE' && request.url.endsWith(`/session/${sessionId}`)) {
+                this.flush(sessionId);
+            }
+
+            response.writeHead(upstreamResponse.statusCode, upstreamResponse.headers);
+            response.end(responseBody);
+        });
+        upstream.on('error', (error) => {
+            response.writeHead(502, { 'content-type': 'application/json' });
+            response.end(JSON.stringify({ value: { error: 'unknown error', message: `Recording proxy: ${error.message}` } }));
+        });
+        upstream.end(body);
+    }
+
+    session(sessionId) {
+        if (!this.sessions.has(sessionId)) {
+            this.sessions.set(sessionId, []);
+        }
+        return this.sessions.get(sessionId);
+    }
+
+    flush(sessionId) {
+        const entries = this.sessions.get(sessionId);
+        if (!entries || entries.length === 0) {
+            return;
+        }
+        const file = path.join(this.dir, `${entries[0].start}-${sessionId}.json`);
+        fs.writeFileSync(file, JSON.stringify({ sessionId, entries }, null, 2));
+        this.sessions.delete(sessionId);
+    }
+}
+
+function readBody(stream) {
+    return new Promise((resolve, reject) => {
+        const chunks = [];
+        stream.on('data', (chunk) => chunks.push(chunk));
+        stream.on('end', () => resolve(Buffer.concat(chunks).toString('utf8')));
+        stream.on('error', reject);
+    });
+}
+
+function parseJson(text) {
+    if (!text) {
+        return null;
+    }
+    try {
+        return JSON.parse(text);
+    } catch (error) {
+        return text;
+    }
+}
+
+module.exports = { RecordingProxy, readBody, parseJson };
@@ -0,0 +1,126 @@
+const fs = require('fs');
+const http = require('http');
+const path = require('path');
+const { readBody, parseJson } = require('./RecordingProxy');
+
+/**
+ * Stand-in WebDriver server that answers with the responses stored by RecordingProxy. A new session
+ * request is served from the first unused recorded session with the same platformName and wdio:specFile
+ * capability, so parallel workers get the session of their own spec rather than the next one, and every
+ * later request is answered with the next unused recorded entry of that session with the same method,
+ * path and body. A request whose body differs from every recorded one fails with the recorded body in the
+ * error, so a run that went off-script fails instead of receiving another request's response.
+ */
+class ReplayServer {
+    /**
+     * @param {Object} options
+     * @param {number} options.port - port to listen on.
+     * @param {string} options.dir - recording directory written by RecordingProxy.
+     * @param {string|number} [options.latency='none'] - 'none', 'recorded', a fixed delay in ms, or 'x<factor>'
+     *     to scale the recorded durations.
+     */
+    constructor({ port, dir, latency = 'none' }) {
+        this.port = port;
+        this.latency = latency;
+        this.recordings = fs.readdirSync(dir)
+            .filter((file) => file.endsWith('.json'))
+            .sort()
+            .map((file) => JSON.parse(fs.readFileSync(path.join(dir, file), 'utf8')))
+            .map((recording) => ({ ...recording, entries: recording.entries.map((entry) => ({ ...entry, used: false })) }));
+        this.server = http.createServer((request, response) => this.handle(request, response));
+    }
+
+    start() {
+        return new Promise((resolve) => this.server.listen(this.port, '127.0.0.1', resolve));
+    }
+
+    stop() {
+        return new Promise((resolve) => this.server.close(resolve));
+    }
+
+    async handle(request, response) {
+        const body = parseJson(await readBody(request));
+        const entry = this.match(request.method, request.url, body);
+
+        const diverged = !entry && this.pending(request.method, request.url)[0];
+        if (diverged) {
+            response.writeHead(500, { 'content-type': 'application/json' });
+            response.end(JSON.stringify({
+                value: {
+                    error: 'unknown error',
+                    message: `Replay diverged from the recording at ${request.method} ${request.url}: `
+                        + `sent ${JSON.stringify(body)}, recorded ${JSON.stringify(diverged.body)}`,
+                    stacktrace: '',
+                },
+            }));
+            return;
+        }
+        if (!entry) {
+            response.writeHead(404, { 'content-type': 'application/json' });
+            response.end(JSON.stringify({
+                value: { error: 'unknown command', message: `No recorded response for ${request.method} ${request.url}`, stacktrace: '' },
+            }));
+            return;
+        }
+
+        entry.used = true;
+        const delay = this.delay(entry);
+        if (delay > 0) {
+            await new Promise((resolve) => setTimeout(resolve, delay));
+        }
+        response.writeHead(entry.status, { 'content-type': 'application/json; charset=utf-8' });
+        response.end(typeof entry.response === 'string' ? entry.response : JSON.stringify(entry.response));
+    }
+
+    match(method, url, body) {
+        const sessionId = (url.match(/\/session\/([^/]+)/) || [])[1];
+        if (!sessionId) {
+            if (method === 'POST' && /\/session\/?$/.test(url)) {
+                const platform = platformName(body);
+                const spec = capability(body, 'wdio:specFile');
+                const recording = this.recordings.find((candidate) => !candidate.entries[0].used
+                    && (!platform || platformName(candidate.entries[0].body) === platform)
+                    && (!spec || capability(candidate.entries[0].body, 'wdio:specFile') === spec));
+                return recording && recording.entries[0];
+            }
+            return this.recordings.flatMap((recording) => recording.entries)
+                .find((entry) => !entry.used && entry.method === method && entry.path === url);
+        }
+
+        const serialized = JSON.stringify(body);
+        return this.pending(method, url).find((entry) => JSON.stringify(entry.body) === serialized);
+    }
+
+    /**
+     * Unused recorded entries of the request's session with the same method and path.
+     */
+    pending(method, url) {
+        const sessionId = (url.match(/\/session\/([^/]+)/) || [])[1];
+        const recording = sessionId && this.recordings.find((candidate) => candidate.sessionId === sessionId);
+        return recording ? recording.entries.filter((entry) => !entry.used && entry.method === method && entry.path === url) : [];
+    }
+
+    delay(entry) {
+        if (this.latency === 'none' || this.latency === undefined) {
+            return 0;
+        }
+        if (this.latency === 'recorded') {
+            return entry.duration || 0;
+        }
+        if (typeof this.latency === 'string' && this.latency.startsWith('x')) {
+            return (entry.duration || 0) * Number(this.latency.slice(1));
+        }
+        return Number(this.latency);
+    }
+}
+
+function capability(body, name) {
+    const caps = body?.capabilities?.alwaysMatch ?? body?.capabilities?.firstMatch?.[0] ?? body?.desiredCapabilities ?? {};
+    return caps[name];
+}
+
+function platformName(body) {
+    return (capability(body, 'platformName') || '').toLowerCase() || undefined;
+}
+
+module.exports = { ReplayServer };
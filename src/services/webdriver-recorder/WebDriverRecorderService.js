@@ -0,0 +1,46 @@
+const path = require('path');
+const { fileURLToPath } = require('url');
+const { RecordingProxy } = require('./RecordingProxy');
+const { ReplayServer } = require('./ReplayServer');
+
+/**
+ * Launcher service that records the WebDriver traffic of a run, or replays a recording without Appium
+ * or a device. Every session is tagged with its spec file (the wdio:specFile capability), so a replay hands each
+ * worker the session recorded for the same spec whatever order the specs start in.
+ *
+ * Options:
+ *   mode        'record' or 'replay'
+ *   port        port WebdriverIO connects to (the config's port)
+ *   targetPort  Appium port requests are forwarded to while recording
+ *   name        recording name, stored under ./recordings/<name>
+ *   latency     replay latency model: 'none', 'recorded', a fixed delay in ms, or 'x<factor>'
+ */
+module.exports = class WebDriverRecorderService {
+    constructor(options) {
+        this.options = { name: 'latest', latency: 'none', ...options };
+        this.dir = path.resolve('recordings', this.options.name);
+    }
+
+    async onPrepare() {
+        const { mode, port, targetPort, latency } = this.options;
+        this.server = mode === 'replay'
+            ? new ReplayServer({ port, dir: this.dir, latency })
+            : new RecordingProxy({ port, targetPort, dir: this.dir });
+        await this.server.start();
+        console.log(`WebDriver ${mode === 'replay' ? 'replay server' : 'recording proxy'} listening on ${port} (${this.dir})`);
+    }
+
+    beforeSession(config, capabilities, specs) {
+        const [spec] = specs;
+        if (spec) {
+            const file = spec.startsWith('file:') ? fileURLToPath(spec) : spec;
+            capabilities['wdio:specFile'] = path.relative(process.cwd(), file).split(path.sep).join('/');
+        }
+    }
+
+    async onComplete() {
+        if (this.server) {
+            await this.server.stop();
+        }
+    }
+};
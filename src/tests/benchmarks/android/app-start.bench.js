@@ -0,0 +1,46 @@
+const path = require('path');
+const { expect } = require('@wdio/globals');
+const budgets = require('../../../data/performance-budgets.json');
+const AppStart = require('../../../utilities/AppStart');
+const Benchmark = require('../../../utilities/Benchmark');
+const { appHash, sessionArtifact } = require('../../../utilities/appArtifact');
+
+const iterations = Number(process.env.BENCHMARK_ITERATIONS || budgets.appStartIterations);
+const warmup = Number(process.env.BENCHMARK_WARMUP ?? budgets.warmup);
+
+describe('App start benchmarks on Android device', () => {
+    for (const type of ['cold', 'warm', 'hot']) {
+        it(`${type} start`, async () => {
+            const refiled = {};
+            let unmeasured = 0;
+            for (let iteration = 0; iteration < warmup + iterations; iteration++) {
+                const start = await AppStart.measure(type);
+                // Record under the state the system reports; a warm start whose process was killed is a cold start.
+                const actual = (start.launchState || type).toLowerCase();
+                if (iteration < warmup) {
+                    continue;
+                }
+                if (start.totalTime === null) {
+                    unmeasured++;
+                    continue;
+                }
+                if (actual !== type) {
+                    refiled[actual] = (refiled[actual] || 0) + 1;
+                }
+                Benchmark.record(`${actual} start`, start.totalTime, { WaitTime: start.waitTime, 'first frame': start.firstFrame });
+            }
+            for (const [actual, count] of Object.entries(refiled)) {
+                console.log(`${count} of ${iterations} requested ${type} starts were reported as ${actual} and filed under '${actual} start'`);
+            }
+            if (unmeasured) {
+                console.warn(`${unmeasured} of ${iterations} ${type} starts reported no TotalTime and were not recorded`);
+            }
+        })
+    }
+
+    it('stays within the app start budgets', () => {
+        console.log(`App start of build ${(appHash(sessionArtifact()) || 'unversioned').slice(0, 12)}:`);
+        Benchmark.write(path.resolve('reports', 'app-start-android.json'));
+        expect(Benchmark.exceeded({ journeys: budgets.android.appStart })).toEqual([]);
+    })
+})
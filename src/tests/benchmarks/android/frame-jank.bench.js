@@ -0,0 +1,30 @@
+const { expect } = require('@wdio/globals');
+const CartPage = require('../../../ui/page-objects/android/CartPage');
+const CatalogPage = require('../../../ui/page-objects/android/CatalogPage');
+const NavigationBar = require('../../../ui/components/navigation/NavigationBarComponent');
+const ProductPage = require('../../../ui/page-objects/android/ProductPage');
+const AppStateReset = require('../../../utilities/AppStateReset');
+const FrameMetrics = require('../../../utilities/FrameMetrics');
+
+describe('Frame jank benchmarks on Android device', () => {
+    beforeEach(async () => {
+        await AppStateReset.reset();
+    });
+
+    it('catalog scroll', async () => {
+        const frames = await FrameMetrics.capture('catalog scroll', () => CatalogPage.scrollToEnd());
+        expect(frames.totalFrames).toBeGreaterThan(0);
+    })
+
+    it('twenty cart quantity increments', async () => {
+        await CatalogPage.selectBackpack();
+        await ProductPage.addItemToCart();
+        await NavigationBar.openCart();
+        const frames = await FrameMetrics.capture('20 cart increments', async () => {
+            for (let increment = 0; increment < 20; increment++) {
+                await CartPage.addOneItem();
+            }
+        });
+        expect(frames.totalFrames).toBeGreaterThan(0);
+    })
+})
@@ -0,0 +1,72 @@
+const path = require('path');
+const { expect } = require('@wdio/globals');
+const CartPage = require('../../../ui/page-objects/android/CartPage');
+const CatalogPage = require('../../../ui/page-objects/android/CatalogPage');
+const CheckoutPage = require('../../../ui/page-objects/android/CheckoutPage');
+const LoginPage = require('../../../ui/page-objects/android/LoginPage');
+const MenuPage = require('../../../ui/page-objects/android/MenuPage');
+const NavigationBar = require('../../../ui/components/navigation/NavigationBarComponent');
+const OrderConfirmationPage = require('../../../ui/page-objects/android/OrderConfirmationPage');
+const PaymentPage = require('../../../ui/page-objects/android/PaymentPage');
+const ProductPage = require('../../../ui/page-objects/android/ProductPage');
+const { testUser } = require('../../../data/users');
+const budgets = require('../../../data/performance-budgets.json');
+const AppStateReset = require('../../../utilities/AppStateReset');
+const Benchmark = require('../../../utilities/Benchmark');
+const Fixtures = require('../../../utilities/Fixtures');
+
+const runs = {
+    iterations: Number(process.env.BENCHMARK_ITERATIONS || budgets.iterations),
+    warmup: Number(process.env.BENCHMARK_WARMUP ?? budgets.warmup),
+};
+
+describe('Journey benchmarks on Android device', () => {
+    it('login', async () => {
+        await Benchmark.journey('login', {
+            ...runs,
+            setup: async () => {
+                await AppStateReset.reset();
+                await NavigationBar.openMenu();
+                await MenuPage.clickLoginBtn();
+            },
+            run: async () => {
+                await Benchmark.step('LoginPage.validLogin', () => LoginPage.validLogin());
+                await Benchmark.step('catalog displayed', () => NavigationBar.appLogo.waitForDisplayed());
+            },
+        });
+    })
+
+    it('addToCart', async () => {
+        await Benchmark.journey('addToCart', {
+            ...runs,
+            setup: async () => {
+                await AppStateReset.reset();
+                await CatalogPage.selectBackpack();
+            },
+            run: async () => {
+                await Benchmark.step('ProductPage.addItemToCart', () => ProductPage.addItemToCart());
+                await Benchmark.step('NavigationBar.openCart', () => NavigationBar.openCart());
+                await Benchmark.step('cart displayed', () => CartPage.proceedToCheckoutBtn.waitForDisplayed());
+            },
+        });
+    })
+
+    it('checkout', async () => {
+        await Benchmark.journey('checkout', {
+            ...runs,
+            setup: () => Fixtures.restore('checkout', { loggedIn: true, cart: [{ product: 'backpack', amount: 1 }] }),
+            run: async () => {
+                await Benchmark.step('CheckoutPage.enterShippingAddressAndroid', () => CheckoutPage.enterShippingAddressAndroid(testUser));
+                await Benchmark.step('PaymentPage.enterPaymentInfo', () => PaymentPage.enterPaymentInfo(testUser));
+                await Benchmark.step('PaymentPage.reviewOrder', () => PaymentPage.reviewOrder());
+                await Benchmark.step('CheckoutPage.placeOrder', () => CheckoutPage.placeOrder());
+                await Benchmark.step('confirmation displayed', () => OrderConfirmationPage.checkoutCompleteText.waitForDisplayed());
+            },
+        });
+    })
+
+    it('stays within the performance budgets', () => {
+        Benchmark.write(path.resolve('reports', 'benchmark-android.json'));
+        expect(Benchmark.exceeded(budgets.android)).toEqual([]);
+    })
+})
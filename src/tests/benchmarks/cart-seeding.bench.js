@@ -0,0 +1,45 @@
+const fs = require('fs');
+const { expect } = require('@wdio/globals');
+const AppStateReset = require('../../utilities/AppStateReset');
+const CartSeeder = require('../../utilities/CartSeeder');
+
+const sizes = [1, 10, 25, 50, 100];
+const modes = ['clickLoop', 'batchedTaps', 'deepLink'];
+const results = [];
+
+/**
+ * Compares cart seeding modes as the number of units grows. Part of 'npm run benchmark'; run on its own with:
+ * npx wdio run ./src/config/wdio.benchmark.conf.js --spec ./src/tests/benchmarks/cart-seeding.bench.js
+ */
+describe('Cart seeding benchmark', () => {
+    beforeEach(async () => {
+        await AppStateReset.reset();
+    });
+
+    for (const amount of sizes) {
+        for (const mode of modes) {
+            it(`seeds ${amount} backpacks via ${mode}`, async () => {
+                const start = Date.now();
+                await CartSeeder.seed('backpack', amount, { mode });
+                const duration = Date.now() - start;
+                results.push({ mode, amount, duration });
+
+                const CartPage = require(`../../ui/page-objects/${driver.isAndroid ? 'android' : 'ios'}/CartPage`);
+                await expect(driver.isAndroid ? CartPage.totalQuantityTextAndroid : CartPage.totalQuantityTextIOS(amount))
+                    .toHaveText(`${amount} Items`);
+            });
+        }
+    }
+
+    after(() => {
+        fs.mkdirSync('./reports', { recursive: true });
+        fs.writeFileSync('./reports/cart-seeding-benchmark.json', JSON.stringify(results, null, 2));
+        for (const amount of sizes) {
+            const row = modes.map((mode) => {
+                const result = results.find((entry) => entry.mode === mode && entry.amount === amount);
+                return `${mode} ${result ? `${result.duration}ms` : 'n/a'}`;
+            });
+            console.log(`${amount} units: ${row.join(', ')}`);
+        }
+    });
+});
@@ -4,12 +4,13 @@ const CartPage = require('../../../ui/page-objects/android/CartPage');
 const CatalogPage = require("../../../ui/page-objects/android/CatalogPage");
 const ProductPage = require("../../../ui/page-objects/android/ProductPage");
 const {calculateTotalPrice} = require("../../../utilities/helpers");
+const AppStateReset = require('../../../utilities/AppStateReset');
 
 const quantity = Math.floor(Math.random() * 10) + 1;
 
 describe('Cart workflow tests on Android device', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
+        await AppStateReset.reset();
         await CatalogPage.selectBackpack();
     });
 
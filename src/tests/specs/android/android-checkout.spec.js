@@ -3,23 +3,18 @@ const CartPage = require('../../../ui/page-objects/android/CartPage');
 const CatalogPage = require('../../../ui/page-objects/android/CatalogPage');
 const CheckoutPage = require('../../../ui/page-objects/android/CheckoutPage');
 const LoginPage = require('../../../ui/page-objects/android/LoginPage');
-const MenuPage = require('../../../ui/page-objects/android/MenuPage');
 const NavigationBar = require('../../../ui/components/navigation/NavigationBarComponent');
 const OrderConfirmationPage = require('../../../ui/page-objects/android/OrderConfirmationPage');
 const PaymentPage = require('../../../ui/page-objects/android/PaymentPage');
 const ProductPage = require('../../../ui/page-objects/android/ProductPage');
 const { testUser } = require("../../../data/users");
+const AppStateReset = require('../../../utilities/AppStateReset');
+const Fixtures = require('../../../utilities/Fixtures');
+const PageSnapshot = require('../../../utilities/PageSnapshot');
 
 describe('Checkout workflow tests for logged in user on Android device', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
-        await NavigationBar.openMenu();
-        await MenuPage.clickLoginBtn();
-        await LoginPage.validLogin();
-        await CatalogPage.selectBackpack();
-        await ProductPage.addItemToCart();
-        await NavigationBar.openCart();
-        await CartPage.proceedToCheckout();
+        await Fixtures.restore('checkout', { loggedIn: true, cart: [{ product: 'backpack', amount: 1 }] });
     });
 
     it('user can complete checkout with valid address and payment info on Android device', async () => {
@@ -42,26 +37,30 @@ describe('Checkout workflow tests for logged in user on Android device', () => {
 
     it('user cannot complete checkout without address info on Android device', async () => {
         await CheckoutPage.clickToPaymentBtn();
-        await expect(CheckoutPage.errorMsgFullName).toHaveText('Please provide your full name.');
-        await expect(CheckoutPage.errorMsgAddressLine1).toHaveText('Please provide your address.');
-        await expect(CheckoutPage.errorMsgCity).toHaveText('Please provide your city.');
-        await expect(CheckoutPage.errorMsgZipCode).toHaveText('Please provide your zip');
-        await expect(CheckoutPage.errorMsgCountry).toHaveText('Please provide your');
+        await PageSnapshot.expectAll([
+            { selector: CheckoutPage.selectors.errorMsgFullName, text: 'Please provide your full name.' },
+            { selector: CheckoutPage.selectors.errorMsgAddressLine1, text: 'Please provide your address.' },
+            { selector: CheckoutPage.selectors.errorMsgCity, text: 'Please provide your city.' },
+            { selector: CheckoutPage.selectors.errorMsgZipCode, text: 'Please provide your zip' },
+            { selector: CheckoutPage.selectors.errorMsgCountry, text: 'Please provide your' },
+        ]);
     })
 
     it('user cannot complete checkout without payment info on Android device', async () => {
         await CheckoutPage.enterShippingAddressAndroid(testUser);
         await PaymentPage.reviewOrder();
-        await expect(PaymentPage.errorMsgCardName).toHaveText('Value looks invalid.');
-        await expect(PaymentPage.cardNumberErrorIcon).toBeDisplayed();
-        await expect(PaymentPage.errorMsgExpirationDate).toHaveText('Value looks invalid.');
-        await expect(PaymentPage.errorMsgSecurityCode).toHaveText('Value looks invalid.');
+        await PageSnapshot.expectAll([
+            { selector: PaymentPage.selectors.errorMsgCardName, text: 'Value looks invalid.' },
+            { selector: PaymentPage.selectors.cardNumberErrorIcon, displayed: true },
+            { selector: PaymentPage.selectors.errorMsgExpirationDate, text: 'Value looks invalid.' },
+            { selector: PaymentPage.selectors.errorMsgSecurityCode, text: 'Value looks invalid.' },
+        ]);
     })
 })
 
 describe('Checkout tests for user without active session on Android device', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
+        await AppStateReset.reset();
         await CatalogPage.selectBackpack();
         await ProductPage.addItemToCart();
         await NavigationBar.openCart();
@@ -3,10 +3,11 @@ const LoginPage = require('../../../ui/page-objects/android/LoginPage');
 const MenuPage = require('../../../ui/page-objects/android/MenuPage');
 const LogoutModal = require('../../../ui/components/modals/LogoutModal');
 const NavigationBar = require('../../../ui/components/navigation/NavigationBarComponent');
+const AppStateReset = require('../../../utilities/AppStateReset');
 
 describe('Successful login page tests', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
+        await AppStateReset.reset();
         await NavigationBar.openMenu();
         await MenuPage.clickLoginBtn();
     });
@@ -27,7 +28,7 @@ describe('Successful login page tests', () => {
 
 describe('Unsuccessful login page tests', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
+        await AppStateReset.reset();
         await NavigationBar.openMenu();
         await MenuPage.clickLoginBtn();
     });
@@ -3,23 +3,17 @@ const CartPage = require('../../../ui/page-objects/ios/CartPage');
 const CatalogPage = require('../../../ui/page-objects/ios/CatalogPage');
 const CheckoutPage = require('../../../ui/page-objects/ios/CheckoutPage');
 const LoginPage = require('../../../ui/page-objects/ios/LoginPage');
-const MenuPage = require('../../../ui/page-objects/ios/MenuPage');
 const NavigationBar = require('../../../ui/components/navigation/NavigationBarComponent');
 const OrderConfirmationPage = require('../../../ui/page-objects/ios/OrderConfirmationPage');
 const PaymentPage = require('../../../ui/page-objects/ios/PaymentPage');
 const ProductPage = require('../../../ui/page-objects/ios/ProductPage');
 const { testUser } = require("../../../data/users");
+const AppStateReset = require('../../../utilities/AppStateReset');
+const Fixtures = require('../../../utilities/Fixtures');
 
 describe('Checkout workflow tests for logged in user on Android device on iOS device', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
-        await NavigationBar.openMenu();
-        await MenuPage.clickLoginBtn();
-        await LoginPage.validLogin();
-        await CatalogPage.selectBackpack();
-        await ProductPage.addItemToCart();
-        await NavigationBar.openCart();
-        await CartPage.proceedToCheckout();
+        await Fixtures.restore('checkout', { loggedIn: true, cart: [{ product: 'backpack', amount: 1 }] });
     });
 
     it('user can complete checkout with valid address and payment info on Android device on iOS device', async () => {
@@ -54,7 +48,7 @@ describe('Checkout workflow tests for logged in user on Android device on iOS de
 
 describe('Checkout tests for user without active session on iOS device', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
+        await AppStateReset.reset();
         await CatalogPage.selectBackpack();
         await ProductPage.addItemToCart();
         await NavigationBar.openCart();
@@ -2,10 +2,11 @@ const { expect } = require('@wdio/globals');
 const LoginPage = require('../../../ui/page-objects/ios/LoginPage');
 const MenuPage = require('../../../ui/page-objects/ios/MenuPage');
 const NavigationBar = require('../../../ui/components/navigation/NavigationBarComponent');
+const AppStateReset = require('../../../utilities/AppStateReset');
 
 describe('Successful login page tests on iOS device', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
+        await AppStateReset.reset();
         await NavigationBar.openMenu();
         await MenuPage.clickLoginBtn();
     });
@@ -25,7 +26,7 @@ describe('Successful login page tests on iOS device', () => {
 
 describe('Unsuccessful login page tests on iOS device', () => {
     beforeEach(async () => {
-        await driver.relaunchActiveApp();
+        await AppStateReset.reset();
         await NavigationBar.openMenu();
         await MenuPage.clickLoginBtn();
     });
@@ -0,0 +1,23 @@
+const assert = require('node:assert');
+const { test } = require('node:test');
+const Benchmark = require('../../utilities/Benchmark');
+
+test('budgeted journeys and steps without results fail the budget check', () => {
+    Benchmark.journeys = {};
+    Benchmark.record('login', 2000, { 'LoginPage.validLogin': 1500 });
+    const budgets = {
+        journeys: {
+            login: { p95: 3000, steps: { 'LoginPage.validLogin': { p95: 1000 }, 'LoginPage.renamedStep': { p95: 1000 } } },
+            checkout: { p95: 20000, steps: { 'CheckoutPage.placeOrder': { p95: 3000 } } },
+        },
+    };
+    assert.deepStrictEqual(Benchmark.exceeded(budgets), [
+        'login → LoginPage.validLogin p95 1500ms exceeds budget 1000ms',
+        'login → LoginPage.renamedStep has a budget but no results',
+        'checkout has a budget but no results',
+    ]);
+});
+
+test('rejects iterations without a total duration', () => {
+    assert.throws(() => Benchmark.record('cold start', null), /must be a number/);
+});
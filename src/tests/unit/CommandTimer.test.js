@@ -0,0 +1,33 @@
+const assert = require('node:assert');
+const { test } = require('node:test');
+const CommandTimer = require('../../utilities/instrumentation/CommandTimer');
+const PageObjectTracer = require('../../utilities/instrumentation/PageObjectTracer');
+
+test('times nested commands once and attributes them to the running page-object method', async () => {
+    const events = [];
+    CommandTimer.subscribe((event, command) => events.push([event, command.commandName, command.nested, command.path]));
+
+    await PageObjectTracer.run('CartPage', 'openCart', async () => {
+        CommandTimer.start('elementClick', ['element-1']);
+        CommandTimer.start('findElement', ['id', 'cartRL']);
+        CommandTimer.end('findElement', ['id', 'cartRL'], {});
+        assert.strictEqual(CommandTimer.idle(), false);
+        CommandTimer.end('elementClick', ['element-1'], null);
+    });
+    CommandTimer.end('getPageSource', []);
+
+    assert.strictEqual(CommandTimer.idle(), true);
+    assert.deepStrictEqual(events, [
+        ['start', 'elementClick', false, 'CartPage.openCart'],
+        ['start', 'findElement', true, 'CartPage.openCart'],
+        ['end', 'findElement', true, 'CartPage.openCart'],
+        ['end', 'elementClick', false, 'CartPage.openCart'],
+    ]);
+});
+
+test('page objects required after the hooks ran are attributed as well', async () => {
+    PageObjectTracer.instrumentOnRequire();
+    const Benchmark = require('../../utilities/Benchmark');
+    const path = await Benchmark.step('lazy', async () => PageObjectTracer.currentPath());
+    assert.strictEqual(path, 'Benchmark.step');
+});
@@ -0,0 +1,28 @@
+const assert = require('node:assert');
+const http = require('http');
+const { test } = require('node:test');
+const MacroClient = require('../../utilities/MacroClient');
+const { driverLocator } = require('../../utilities/page-source/selectors');
+
+test('converts CSS attribute selectors to locators the drivers support', () => {
+    assert.deepStrictEqual(driverLocator('button[name="Login"]', 'ios'),
+        { using: 'xpath', value: '//XCUIElementTypeButton[@name="Login"]' });
+    assert.deepStrictEqual(driverLocator('[id="com.saucelabs.mydemoapp.android:id/buttonLL"]', 'android'),
+        { using: 'id', value: 'com.saucelabs.mydemoapp.android:id/buttonLL' });
+    assert.deepStrictEqual(driverLocator('~Login', 'ios'), { using: 'accessibility id', value: 'Login' });
+    assert.throws(() => driverLocator('.some-class', 'ios'), /cannot be sent/);
+});
+
+test('a non-JSON 404 from a server without the plugin marks the endpoint unsupported', async () => {
+    const server = http.createServer((request, response) => {
+        response.writeHead(404, { 'content-type': 'text/html' });
+        response.end('<html>Not Found</html>');
+    });
+    await new Promise((resolve) => server.listen(0, '127.0.0.1', resolve));
+    const browser = { sessionId: 'abc', options: { hostname: '127.0.0.1', port: server.address().port, waitforTimeout: 1000 } };
+    try {
+        await assert.rejects(MacroClient.run(browser, []), (error) => error.unsupported === true);
+    } finally {
+        server.close();
+    }
+});
@@ -0,0 +1,59 @@
+const assert = require('node:assert');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { test } = require('node:test');
+const { ReplayServer } = require('../../services/webdriver-recorder/ReplayServer');
+
+test('a request that diverges from the recording fails instead of getting the next recorded response', async () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'replay-'));
+    fs.writeFileSync(path.join(dir, 'session.json'), JSON.stringify({
+        sessionId: 's1',
+        entries: [
+            { method: 'POST', path: '/session/s1/element/a/click', body: {}, status: 200, response: { value: null } },
+            { method: 'POST', path: '/session/s1/element', body: { using: 'id', value: 'login' }, status: 200, response: { value: { element: 'a' } } },
+        ],
+    }));
+    const server = new ReplayServer({ port: 0, dir });
+    await server.start();
+    const url = `http://127.0.0.1:${server.server.address().port}/session/s1/element`;
+    try {
+        const diverged = await fetch(url, { method: 'POST', body: JSON.stringify({ using: 'id', value: 'logout' }) });
+        assert.strictEqual(diverged.status, 500);
+        assert.match((await diverged.json()).value.message, /diverged.*"logout".*"login"/);
+
+        const matching = await fetch(url, { method: 'POST', body: JSON.stringify({ using: 'id', value: 'login' }) });
+        assert.deepStrictEqual(await matching.json(), { value: { element: 'a' } });
+    } finally {
+        await server.stop();
+    }
+});
+
+test('a new session gets the recording of its own spec, whatever order the specs start in', async () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'replay-'));
+    for (const [sessionId, spec] of [['s1', 'src/tests/specs/android/login.spec.js'], ['s2', 'src/tests/specs/android/cart.spec.js']]) {
+        fs.writeFileSync(path.join(dir, `${sessionId}.json`), JSON.stringify({
+            sessionId,
+            entries: [{
+                method: 'POST',
+                path: '/session',
+                body: { capabilities: { alwaysMatch: { platformName: 'Android', 'wdio:specFile': spec } } },
+                status: 200,
+                response: { value: { sessionId } },
+            }],
+        }));
+    }
+    const server = new ReplayServer({ port: 0, dir });
+    await server.start();
+    const url = `http://127.0.0.1:${server.server.address().port}/session`;
+    const newSession = async (spec) => (await (await fetch(url, {
+        method: 'POST',
+        body: JSON.stringify({ capabilities: { alwaysMatch: { platformName: 'Android', 'wdio:specFile': spec } } }),
+    })).json()).value.sessionId;
+    try {
+        assert.strictEqual(await newSession('src/tests/specs/android/cart.spec.js'), 's2');
+        assert.strictEqual(await newSession('src/tests/specs/android/login.spec.js'), 's1');
+    } finally {
+        await server.stop();
+    }
+});
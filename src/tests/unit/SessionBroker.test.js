@@ -0,0 +1,112 @@
+const assert = require('node:assert');
+const http = require('http');
+const { test } = require('node:test');
+const { SessionBroker } = require('../../services/session-broker/SessionBroker');
+
+/**
+ * Minimal stand-in for Appium: creates sessions with increasing ids and records the capabilities they were created with.
+ */
+async function fakeAppium() {
+    const sessions = new Map();
+    let next = 0;
+    const server = http.createServer((request, response) => {
+        let body = '';
+        request.on('data', (chunk) => { body += chunk; });
+        request.on('end', () => {
+            let value = null;
+            if (request.method === 'POST' && request.url === '/session') {
+                const sessionId = `session-${next++}`;
+                sessions.set(sessionId, JSON.parse(body).capabilities.alwaysMatch);
+                value = { sessionId, capabilities: {} };
+            } else if (request.method === 'DELETE') {
+                sessions.delete(request.url.split('/').pop());
+            }
+            response.writeHead(200, { 'content-type': 'application/json' });
+            response.end(JSON.stringify({ value }));
+        });
+    });
+    await new Promise((resolve) => server.listen(0, '127.0.0.1', resolve));
+    return { server, sessions, port: server.address().port };
+}
+
+async function newSession(port, alwaysMatch) {
+    const response = await fetch(`http://127.0.0.1:${port}/session`, {
+        method: 'POST',
+        body: JSON.stringify({ capabilities: { alwaysMatch, firstMatch: [{}] } }),
+    });
+    return (await response.json()).value.sessionId;
+}
+
+const android = { platformName: 'Android', 'appium:automationName': 'UiAutomator2', 'appium:appPackage': 'com.example' };
+
+test('queues session requests while every device is leased', async () => {
+    const appium = await fakeAppium();
+    const broker = new SessionBroker({ port: 0, targetPort: appium.port, devices: [] });
+    await broker.start();
+    const { port } = broker.server.address();
+    try {
+        broker.prewarm([android]);
+        const first = await newSession(port, android);
+        let secondDone = false;
+        const second = newSession(port, android).then((id) => { secondDone = true; return id; });
+        await new Promise((resolve) => setTimeout(resolve, 100));
+        assert.strictEqual(secondDone, false);
+
+        await fetch(`http://127.0.0.1:${port}/session/${first}`, { method: 'DELETE' });
+        assert.notStrictEqual(await second, first);
+    } finally {
+        await broker.stop();
+        appium.server.close();
+    }
+});
+
+test('does not hand out a warm session created for another device', async () => {
+    const appium = await fakeAppium();
+    const broker = new SessionBroker({ port: 0, targetPort: appium.port, devices: [] });
+    await broker.start();
+    const { port } = broker.server.address();
+    try {
+        broker.prewarm([{ ...android, 'appium:deviceName': 'Pixel 7' }]);
+        const sessionId = await newSession(port, { ...android, 'appium:deviceName': 'Pixel 8' });
+        assert.strictEqual(appium.sessions.get(sessionId)['appium:deviceName'], 'Pixel 8');
+        assert.strictEqual(appium.sessions.size, 1);
+    } finally {
+        await broker.stop();
+        appium.server.close();
+    }
+});
+
+test('hands out the warm session to a worker whose capabilities were changed by AppProvisioningService', async () => {
+    const appium = await fakeAppium();
+    const broker = new SessionBroker({ port: 0, targetPort: appium.port, devices: [] });
+    await broker.start();
+    const { port } = broker.server.address();
+    try {
+        const configured = { ...android, 'appium:App': '/builds/app.apk' };
+        broker.prewarm([configured]);
+        const warm = await broker.slots[0].warm;
+        // What AppProvisioningService.beforeSession leaves when the app and the UiAutomator2 server are up to date.
+        const provisioned = { ...android, 'appium:noReset': true, 'appium:skipServerInstallation': true };
+        assert.strictEqual(await newSession(port, provisioned), warm.sessionId);
+        assert.strictEqual(appium.sessions.size, 1);
+    } finally {
+        await broker.stop();
+        appium.server.close();
+    }
+});
+
+test('takes back leases of workers that stopped sending commands', async () => {
+    const appium = await fakeAppium();
+    const broker = new SessionBroker({ port: 0, targetPort: appium.port, devices: [], leaseTimeout: 50 });
+    await broker.start();
+    const { port } = broker.server.address();
+    try {
+        const abandoned = await newSession(port, android);
+        const next = await newSession(port, android);
+        assert.notStrictEqual(next, abandoned);
+        assert.strictEqual(appium.sessions.has(abandoned), false);
+    } finally {
+        await broker.stop();
+        appium.server.close();
+    }
+});
@@ -0,0 +1,72 @@
+const assert = require('node:assert');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const { test } = require('node:test');
+const SpecSchedulerService = require('../../services/SpecSchedulerService');
+
+test('predicts the makespan per capability on its own workers', () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'spec-scheduler-'));
+    const key = (file) => path.relative(process.cwd(), path.join(dir, file)).split(path.sep).join('/');
+    const files = {};
+    for (const file of ['android/a.spec.js', 'android/b.spec.js', 'android/c.spec.js', 'ios/a.spec.js']) {
+        fs.mkdirSync(path.dirname(path.join(dir, file)), { recursive: true });
+        fs.writeFileSync(path.join(dir, file), '');
+        files[key(file)] = [10000];
+    }
+    const historyFile = path.join(dir, 'spec-history.json');
+    fs.writeFileSync(historyFile, JSON.stringify({ files, tests: {} }));
+
+    const lines = [];
+    const log = console.log;
+    console.log = (line) => lines.push(line);
+    try {
+        new SpecSchedulerService({ historyFile }).onPrepare({ maxInstances: 4, rootDir: dir }, [
+            { platformName: 'Android', 'appium:deviceName': 'emulator', maxInstances: 1, specs: ['./android/*.spec.js'] },
+            { platformName: 'iOS', 'appium:deviceName': 'simulator', specs: ['./ios/*.spec.js'] },
+        ]);
+    } finally {
+        console.log = log;
+        fs.rmSync(dir, { recursive: true });
+    }
+    assert.deepStrictEqual(lines, [
+        'Spec scheduler: Android emulator: 3 spec files longest-first on 1 workers, predicted 30.0s',
+        'Spec scheduler: iOS simulator: 1 spec files longest-first on 4 workers, predicted 10.0s',
+        'Spec scheduler: predicted makespan of the run 30.0s',
+    ]);
+});
+
+test('reports whether workers received the spec files in the planned order', () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'spec-scheduler-'));
+    const key = (file) => path.relative(process.cwd(), path.join(dir, file)).split(path.sep).join('/');
+    const files = {};
+    for (const [file, duration] of [['a.spec.js', 1000], ['b.spec.js', 3000], ['c.spec.js', 2000]]) {
+        fs.writeFileSync(path.join(dir, file), '');
+        files[key(file)] = [duration];
+    }
+    const historyFile = path.join(dir, 'spec-history.json');
+    fs.writeFileSync(historyFile, JSON.stringify({ files, tests: {} }));
+    const run = (received) => {
+        const lines = [];
+        const log = console.log;
+        console.log = (line) => lines.push(line);
+        try {
+            const scheduler = new SpecSchedulerService({ historyFile });
+            scheduler.onPrepare({ maxInstances: 1, rootDir: dir }, [{ platformName: 'Android', specs: ['./*.spec.js'] }]);
+            received.forEach((file, index) => scheduler.onWorkerStart(`0-${index}`, {}, [pathToFileURL(path.join(dir, file)).href]));
+            scheduler.onComplete();
+        } finally {
+            console.log = log;
+        }
+        return lines.at(-1);
+    };
+    try {
+        assert.strictEqual(run(['b.spec.js', 'c.spec.js', 'a.spec.js']),
+            'Spec scheduler: Android: workers received 3 spec files in the planned order');
+        assert.strictEqual(run(['a.spec.js', 'b.spec.js', 'c.spec.js']),
+            `Spec scheduler: Android: workers received ${key('a.spec.js')} as spec file 1, planned ${key('b.spec.js')}`);
+    } finally {
+        fs.rmSync(dir, { recursive: true });
+    }
+});
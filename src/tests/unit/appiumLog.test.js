@@ -0,0 +1,39 @@
+const assert = require('node:assert');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { test } = require('node:test');
+const { readAppiumLog, sessionStartupPhases } = require('../../utilities/appiumLog');
+
+const SESSION = '1a2b3c4d-0000-4000-8000-000000000000';
+const DRIVER = '[AndroidUiautomator2Driver@ab12]';
+
+test('UiAutomator2 server package lines count as server install, not app install', () => {
+    const lines = [
+        ['00.000', '[HTTP] --> POST /session'],
+        ['00.100', `${DRIVER} Retrieving device list`],
+        ['01.000', `${DRIVER} Checking app cert for /apps/mda.apk`],
+        ['03.000', `${DRIVER} Uninstalling io.appium.uiautomator2.server`],
+        ['04.000', `${DRIVER} Installing '/node_modules/appium-uiautomator2-server/apks/appium-uiautomator2-server-v7.apk'`],
+        ['07.000', `${DRIVER} Starting UIAutomator2 server 7.0.0`],
+        ['09.000', `${DRIVER} UiAutomator2 server is ready`],
+        ['10.000', `${DRIVER} New AndroidUiautomator2Driver session created successfully, session ${SESSION} added to master session list`],
+        ['10.500', '[HTTP] <-- POST /session 200 10500 ms'],
+    ];
+    const file = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'appium-log-')), 'appium.log');
+    fs.writeFileSync(file, lines.map(([time, message]) => `2026-01-01 12:00:${time} - ${message}`).join('\n'));
+    try {
+        const { phases, total } = sessionStartupPhases(readAppiumLog(file), SESSION);
+        assert.strictEqual(total, 10500);
+        assert.deepStrictEqual(phases, {
+            'session request': 100,
+            'adb device discovery': 900,
+            'app install': 2000,
+            'uiautomator2 server install': 4000,
+            'uiautomator2 server boot': 2000,
+            'app launch': 1500,
+        });
+    } finally {
+        fs.rmSync(path.dirname(file), { recursive: true });
+    }
+});
@@ -0,0 +1,102 @@
+const assert = require('node:assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { test } = require('node:test');
+const { parseXml } = require('../../utilities/page-source/parseXml');
+const { findAll, driverLocator } = require('../../utilities/page-source/selectors');
+
+// Minimal trees in the UiAutomator2 and XCUITest page-source formats; they exercise the engine's semantics and are
+// not snapshots of the app.
+const ANDROID = parseXml(`<hierarchy>
+    <android.widget.FrameLayout resource-id="">
+        <androidx.recyclerview.widget.RecyclerView resource-id="pkg:id/list" scrollable="true">
+            <android.view.ViewGroup resource-id="pkg:id/row">
+                <android.widget.TextView resource-id="pkg:id/title" text="First item" />
+                <android.widget.FrameLayout resource-id="pkg:id/actions">
+                    <android.widget.Button resource-id="pkg:id/add" text="Add" content-desc="Add first" />
+                </android.widget.FrameLayout>
+            </android.view.ViewGroup>
+            <android.view.ViewGroup resource-id="pkg:id/row">
+                <android.widget.TextView resource-id="pkg:id/title" text="Second item" />
+                <android.widget.Button resource-id="pkg:id/add" text="Add" content-desc="Add second" />
+            </android.view.ViewGroup>
+        </androidx.recyclerview.widget.RecyclerView>
+        <android.widget.EditText resource-id="pkg:id/nameET" text="" />
+    </android.widget.FrameLayout>
+</hierarchy>`);
+
+const IOS = parseXml(`<AppiumAUT>
+    <XCUIElementTypeApplication type="XCUIElementTypeApplication" name="App">
+        <XCUIElementTypeOther type="XCUIElementTypeOther" name="Form-screen">
+            <XCUIElementTypeOther type="XCUIElementTypeOther" />
+            <XCUIElementTypeOther type="XCUIElementTypeOther">
+                <XCUIElementTypeButton type="XCUIElementTypeButton" name="first" label="First" />
+                <XCUIElementTypeButton type="XCUIElementTypeButton" name="second" label="Second" />
+                <XCUIElementTypeTextField type="XCUIElementTypeTextField" value="Placeholder" />
+                <XCUIElementTypeStaticText type="XCUIElementTypeStaticText" name="Title" label="Form" />
+            </XCUIElementTypeOther>
+        </XCUIElementTypeOther>
+    </XCUIElementTypeApplication>
+</AppiumAUT>`);
+
+const find = (document, selector, platform) => findAll(document, selector, platform)
+    .map((node) => node.attributes['content-desc'] || node.attributes['resource-id'] || node.attributes.name || node.attributes.value);
+
+test('UiSelector: attributes, instance, childSelector and UiScrollable targets', () => {
+    assert.deepStrictEqual(find(ANDROID, 'android=new UiSelector().resourceId("pkg:id/add")', 'android'), ['Add first', 'Add second']);
+    assert.deepStrictEqual(find(ANDROID, 'android=new UiSelector().resourceId("pkg:id/add").instance(1)', 'android'), ['Add second']);
+    assert.deepStrictEqual(find(ANDROID, 'android=new UiSelector().scrollable(true)', 'android'), ['pkg:id/list']);
+    assert.strictEqual(findAll(ANDROID, 'android=new UiSelector().scrollable(true).childSelector(new UiSelector().textStartsWith("item"))',
+        'android').length, 0);
+    assert.strictEqual(findAll(ANDROID, 'android=new UiSelector().scrollable(true).childSelector(new UiSelector().textContains("item"))',
+        'android').length, 2);
+    assert.deepStrictEqual(find(ANDROID, 'android=new UiScrollable(new UiSelector().scrollable(true))'
+        + '.scrollIntoView(new UiSelector().text("Second item"))', 'android'), ['pkg:id/title']);
+});
+
+test('UiSelector: fromParent searches the whole subtree of the parent', () => {
+    assert.deepStrictEqual(find(ANDROID, 'android=new UiSelector().text("First item").fromParent(new UiSelector().text("Add"))', 'android'),
+        ['Add first']);
+});
+
+test('class chain: descendant and child segments, predicates and 1-based indexes', () => {
+    assert.deepStrictEqual(find(IOS, '-ios class chain:**/XCUIElementTypeOther[`name == "Form-screen"`]/XCUIElementTypeOther[2]'
+        + '/XCUIElementTypeButton[1]', 'ios'), ['first']);
+    assert.deepStrictEqual(find(IOS, '-ios class chain:**/XCUIElementTypeTextField[`value == "Placeholder"`]', 'ios'), ['Placeholder']);
+    assert.deepStrictEqual(find(IOS, '-ios class chain:**/XCUIElementTypeButton[-1]', 'ios'), ['second']);
+    assert.deepStrictEqual(find(IOS, '-ios class chain:XCUIElementTypeButton', 'ios'), []);
+});
+
+test('predicate string: comparisons joined with AND and string operators', () => {
+    assert.deepStrictEqual(find(IOS, '-ios predicate string:name == "Title" AND label == "Form"', 'ios'), ['Title']);
+    assert.deepStrictEqual(find(IOS, "-ios predicate string:type == 'XCUIElementTypeButton' AND label BEGINSWITH 'Sec'", 'ios'), ['second']);
+});
+
+test('CSS: resource ids with or without the package, attributes and iOS tag names', () => {
+    assert.deepStrictEqual(find(ANDROID, '[id="pkg:id/nameET"]', 'android'), ['pkg:id/nameET']);
+    assert.deepStrictEqual(find(ANDROID, '#nameET', 'android'), ['pkg:id/nameET']);
+    assert.deepStrictEqual(find(ANDROID, '[description*="second"]', 'android'), ['Add second']);
+    assert.deepStrictEqual(find(IOS, 'button[name="second"]', 'ios'), ['second']);
+});
+
+test('XPath: the locators driverLocator sends on iOS, positions and wrapped paths', () => {
+    assert.deepStrictEqual(find(IOS, driverLocator('button[name="first"]', 'ios').value, 'ios'), ['first']);
+    assert.deepStrictEqual(find(IOS, '//XCUIElementTypeButton[starts-with(@label, "S")]', 'ios'), ['second']);
+    assert.deepStrictEqual(find(IOS, '(//XCUIElementTypeButton)[2]', 'ios'), ['second']);
+    assert.deepStrictEqual(find(IOS, '//XCUIElementTypeOther/XCUIElementTypeButton[1]', 'ios'), ['first']);
+    assert.throws(() => findAll(IOS, '//XCUIElementTypeButton[text()="First"]', 'ios'), /Unsupported XPath predicate/);
+});
+
+test('check-selectors fails when a platform has no snapshots', () => {
+    const tool = path.resolve(__dirname, '../../tools/check-selectors.js');
+    const empty = fs.mkdtempSync(path.join(os.tmpdir(), 'page-sources-'));
+    try {
+        const result = spawnSync(process.execPath, [tool, empty], { encoding: 'utf8' });
+        assert.strictEqual(result.status, 1);
+        assert.match(result.stdout, /FAIL android: no page-source snapshots/);
+    } finally {
+        fs.rmSync(empty, { recursive: true });
+    }
+});
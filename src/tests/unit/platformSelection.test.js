@@ -0,0 +1,30 @@
+const assert = require('node:assert');
+const path = require('path');
+const { test } = require('node:test');
+const { selectCapabilities } = require('../../utilities/platformSelection');
+
+const baseDir = path.resolve(__dirname, '../../config');
+const capabilities = [
+    { platformName: 'Android', 'appium:deviceName': 'emulator', specs: ['../tests/specs/android/**/*.js'] },
+    { platformName: 'iOS', 'appium:deviceName': 'simulator', specs: ['../tests/specs/ios/**/*.js'] },
+];
+const select = (argv, hostPlatform = 'darwin') => selectCapabilities(capabilities, { argv, baseDir, hostPlatform })
+    .map((capability) => capability.platformName);
+
+test('keeps every capability without --spec', () => {
+    assert.deepStrictEqual(select(['node', 'wdio']), ['Android', 'iOS']);
+});
+
+test('keeps only the capabilities owning a selected spec', () => {
+    assert.deepStrictEqual(select(['--spec', './src/tests/specs/android/android-cart.spec.js']), ['Android']);
+    assert.deepStrictEqual(select(['--spec=./src/tests/specs/ios/ios-cart.spec.js']), ['iOS']);
+});
+
+test('keeps every capability for specs outside all capability globs (README cart seeding benchmark)', () => {
+    assert.deepStrictEqual(select(['--spec', './src/tests/benchmarks/cart-seeding.bench.js']), ['Android', 'iOS']);
+    assert.deepStrictEqual(select(['--spec=./tests/specs/android/android-cart.spec.js']), ['Android', 'iOS']);
+});
+
+test('drops iOS on hosts other than macOS', () => {
+    assert.deepStrictEqual(select(['node', 'wdio'], 'linux'), ['Android']);
+});
@@ -0,0 +1,27 @@
+const assert = require('node:assert');
+const { test, afterEach } = require('node:test');
+const { expandCapabilities } = require('../../utilities/testSharding');
+
+const android = { platformName: 'Android', 'appium:deviceName': 'emulator' };
+
+afterEach(() => {
+    delete process.env.TEST_SHARD_DEVICES;
+});
+
+test('gives every shard copy its own device and system port', () => {
+    process.env.TEST_SHARD_DEVICES = 'emulator-5554,emulator-5556';
+    assert.deepStrictEqual(expandCapabilities([android], 2).map((copy) => [copy['appium:udid'], copy['appium:systemPort']]),
+        [['emulator-5554', 8200], ['emulator-5556', 8201]]);
+});
+
+test('refuses to fan the shards out onto fewer devices', () => {
+    process.env.TEST_SHARD_DEVICES = 'emulator-5554';
+    assert.throws(() => expandCapabilities([android], 2), /TEST_SHARDS=2 needs as many devices in TEST_SHARD_DEVICES \(Android\), got 1/);
+    assert.throws(() => expandCapabilities([android], 3), /got 1/);
+});
+
+test('does not need devices for capabilities assigned elsewhere', () => {
+    const copies = expandCapabilities([android], 3, { devicesAssigned: (capability) => capability.platformName === 'Android' });
+    assert.strictEqual(copies.length, 3);
+    assert.ok(copies.every((copy) => !copy['appium:udid']));
+});
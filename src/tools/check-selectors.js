@@ -0,0 +1,129 @@
+/**
+ * Checks every page-object selector against stored page-source snapshots without a device.
+ *
+ * Usage: node src/tools/check-selectors.js [snapshotDir]
+ *
+ * Snapshots are the XML files in src/data/page-sources/{android,ios}, captured from real sessions by running
+ * the suite with CAPTURE_PAGE_SOURCE=1. A selector passes when it matches an element in at least one snapshot
+ * of its platform; selectors that match nowhere, or that use an unsupported dialect, fail the run, and so does a
+ * platform without snapshots.
+ */
+const fs = require('fs');
+const path = require('path');
+const Module = require('module');
+const { parseXml } = require('../utilities/page-source/parseXml');
+const { findAll } = require('../utilities/page-source/selectors');
+
+const SRC = path.join(__dirname, '..');
+const snapshotDir = process.argv[2] || path.join(SRC, 'data', 'page-sources');
+
+let recorded = [];
+const recordingSelector = (selector) => {
+    recorded.push(selector);
+    return { selector, then: (resolve) => resolve({}) };
+};
+
+// Page objects read selectors through $ from @wdio/globals; record them instead of querying a device.
+const load = Module._load;
+Module._load = function (request, parent, isMain) {
+    if (request === '@wdio/globals') {
+        return { $: recordingSelector, $$: recordingSelector, driver: global.driver, browser: global.driver, expect: () => {} };
+    }
+    return load.call(this, request, parent, isMain);
+};
+
+function listFiles(dir, extension) {
+    if (!fs.existsSync(dir)) {
+        return [];
+    }
+    return fs.readdirSync(dir, { withFileTypes: true }).flatMap((entry) => {
+        const fullPath = path.join(dir, entry.name);
+        return entry.isDirectory() ? listFiles(fullPath, extension) : entry.name.endsWith(extension) ? [fullPath] : [];
+    });
+}
+
+/**
+ * Collects the selectors returned by every parameterless getter (and the selectors map) of the page objects
+ * and components used on a platform.
+ */
+function collectSelectors(platform) {
+    global.driver = { isAndroid: platform === 'android', isIOS: platform === 'ios', sessionId: 'offline' };
+    const files = [
+        ...listFiles(path.join(SRC, 'ui', 'page-objects', platform), '.js'),
+        ...listFiles(path.join(SRC, 'ui', 'components'), '.js'),
+    ];
+    const results = [];
+
+    for (const file of files) {
+        for (const cached of Object.keys(require.cache)) {
+            if (cached.startsWith(path.join(SRC, 'ui')) || cached.includes(`${path.sep}utilities${path.sep}ElementCache`)) {
+                delete require.cache[cached];
+            }
+        }
+        const exported = require(file);
+        const instance = typeof exported === 'function' ? new exported() : exported;
+        const source = path.relative(SRC, file);
+        const getters = new Set();
+        for (let proto = Object.getPrototypeOf(instance); proto && proto !== Object.prototype; proto = Object.getPrototypeOf(proto)) {
+            for (const [name, descriptor] of Object.entries(Object.getOwnPropertyDescriptors(proto))) {
+                if (descriptor.get) {
+                    getters.add(name);
+                }
+            }
+        }
+
+        for (const getter of getters) {
+            recorded = [];
+            const value = instance[getter];
+            const selectors = getter === 'selectors' ? Object.values(value) : recorded;
+            for (const selector of selectors) {
+                results.push({ platform, source, getter, selector });
+            }
+        }
+    }
+    return results;
+}
+
+/**
+ * Shared components hold some single-platform getters; skip selectors that can only belong to the other platform.
+ */
+function belongsTo(selector, platform) {
+    const android = selector.startsWith('android=') || /android:id\/|\.android:id\//.test(selector);
+    const ios = selector.startsWith('-ios ') || selector.includes('XCUIElementType');
+    return platform === 'android' ? !ios : !android;
+}
+
+function main() {
+    let failures = 0;
+    for (const platform of ['android', 'ios']) {
+        const snapshots = listFiles(path.join(snapshotDir, platform), '.xml')
+            .map((file) => ({ file, document: parseXml(fs.readFileSync(file, 'utf8')) }));
+        if (snapshots.length === 0) {
+            failures++;
+            console.log(`FAIL ${platform}: no page-source snapshots in ${path.join(snapshotDir, platform)}`);
+            continue;
+        }
+
+        const seen = new Set();
+        for (const { source, getter, selector } of collectSelectors(platform)) {
+            if (seen.has(selector) || !belongsTo(selector, platform)) {
+                continue;
+            }
+            seen.add(selector);
+            try {
+                const matches = snapshots.filter(({ document }) => findAll(document, selector, platform).length > 0);
+                if (matches.length === 0) {
+                    failures++;
+                    console.log(`FAIL ${platform} ${source} ${getter}: ${selector} matches no snapshot`);
+                }
+            } catch (error) {
+                failures++;
+                console.log(`FAIL ${platform} ${source} ${getter}: ${error.message}`);
+            }
+        }
+        console.log(`${platform}: checked ${seen.size} selectors against ${snapshots.length} snapshots`);
+    }
+    process.exitCode = failures ? 1 : 0;
+}
+
+main();
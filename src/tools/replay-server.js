@@ -0,0 +1,14 @@
+/**
+ * Starts the stand-in WebDriver server on its own, e.g. to drive a recorded session from another tool.
+ *
+ * Usage: node src/tools/replay-server.js [recordingName] [port] [latency]
+ */
+const path = require('path');
+const { ReplayServer } = require('../services/webdriver-recorder/ReplayServer');
+
+const [name = 'latest', port = '4730', latency = 'none'] = process.argv.slice(2);
+const server = new ReplayServer({ port: Number(port), dir: path.resolve('recordings', name), latency });
+
+server.start().then(() => {
+    console.log(`Replaying recordings/${name} on port ${port} (latency: ${latency})`);
+});
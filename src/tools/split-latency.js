@@ -0,0 +1,123 @@
+/**
+ * Splits the command time of every page-object method into the layers it was spent in, by joining the client-side
+ * command timings of CommandLatencyService with the timestamped Appium server logs of the same run.
+ *
+ * Usage: node src/tools/split-latency.js [reportsDir] [logDir]
+ *
+ * Per method, the time is split into:
+ *   client overhead   command time outside any HTTP request (WebdriverIO, hooks, page-object code)
+ *   HTTP transport    request round trip minus the time Appium spent on the request
+ *   Appium routing    Appium time outside proxied calls (routing, driver code, plugins)
+ *   driver proxy      proxied call overhead: the fastest proxied call of the session, taken as the cost of an empty
+ *                     round trip to the UiAutomator2 server or WebDriverAgent
+ *   device execution  the rest of the proxied call time
+ * Client and server clocks are the same machine's, so Appium must run locally with --log-timestamp --local-timezone.
+ * Writes split-latency.json to the reports directory.
+ */
+const fs = require('fs');
+const path = require('path');
+const { readAppiumLog, sessionRequests } = require('../utilities/appiumLog');
+
+const reportsDir = path.resolve(process.argv[2] || 'reports');
+const logDir = path.resolve(process.argv[3] || '.');
+const LAYERS = ['client overhead', 'HTTP transport', 'Appium routing', 'driver proxy', 'device execution'];
+// Client and log timestamps are both taken in ms on the same clock, but at slightly different points.
+const TOLERANCE = 5;
+
+function readSamples() {
+    if (!fs.existsSync(reportsDir)) {
+        return [];
+    }
+    return fs.readdirSync(reportsDir)
+        .filter((file) => /^command-latency-.+\.json$/.test(file))
+        .flatMap((file) => JSON.parse(fs.readFileSync(path.join(reportsDir, file), 'utf8')).samples);
+}
+
+function readLogs() {
+    return fs.readdirSync(logDir)
+        .filter((file) => /^(wdio-)?appium.*\.log$/.test(file))
+        .map((file) => readAppiumLog(path.join(logDir, file)));
+}
+
+/**
+ * Attributes each server-side request to the innermost client command that was running while it was handled.
+ */
+function attachRequests(samples, logs) {
+    const bySession = new Map();
+    for (const sample of samples) {
+        (bySession.get(sample.sessionId) || bySession.set(sample.sessionId, []).get(sample.sessionId)).push(sample);
+    }
+    let matched = 0;
+    for (const [sessionId, sessionSamples] of bySession) {
+        const requests = logs.flatMap((entries) => sessionRequests(entries, sessionId));
+        const proxied = requests.filter((request) => request.proxied > 0);
+        const floor = proxied.length ? Math.min(...proxied.map((request) => request.proxy / request.proxied)) : 0;
+        for (const request of requests) {
+            const owner = sessionSamples
+                .filter((sample) => sample.start <= request.received + TOLERANCE && sample.end >= request.responded - TOLERANCE)
+                .sort((a, b) => a.duration - b.duration)[0];
+            if (owner) {
+                (owner.requests = owner.requests || []).push({ ...request, proxyFloor: floor * request.proxied });
+                matched++;
+            }
+        }
+    }
+    return matched;
+}
+
+function splitByMethod(samples) {
+    const methods = {};
+    for (const sample of samples) {
+        const method = methods[sample.method] = methods[sample.method] || { total: 0, commands: 0, layers: Object.fromEntries(LAYERS.map((layer) => [layer, 0])) };
+        if (!sample.nested) {
+            method.total += sample.duration;
+            method.commands++;
+        }
+        const requests = sample.requests || [];
+        const server = requests.reduce((sum, request) => sum + request.server, 0);
+        const proxy = requests.reduce((sum, request) => sum + request.proxy, 0);
+        const proxyFloor = requests.reduce((sum, request) => sum + Math.min(request.proxyFloor, request.proxy), 0);
+        // Without a client-side round trip (older WebdriverIO), transport is not separable and counts as client time.
+        const http = sample.http ?? server;
+        method.layers['HTTP transport'] += Math.max(0, http - server);
+        method.layers['Appium routing'] += Math.max(0, server - proxy);
+        method.layers['driver proxy'] += proxyFloor;
+        method.layers['device execution'] += Math.max(0, proxy - proxyFloor);
+    }
+    for (const method of Object.values(methods)) {
+        const accounted = LAYERS.slice(1).reduce((sum, layer) => sum + method.layers[layer], 0);
+        method.layers['client overhead'] = Math.max(0, method.total - accounted);
+    }
+    return methods;
+}
+
+function bar(layers, total, width = 40) {
+    const symbols = ['c', 'h', 'a', 'p', 'd'];
+    return LAYERS.map((layer, index) => symbols[index].repeat(total ? Math.round((layers[layer] / total) * width) : 0)).join('');
+}
+
+function main() {
+    const samples = readSamples();
+    if (samples.length === 0) {
+        console.log(`No command-latency-*.json in ${reportsDir}; run the suite first`);
+        process.exitCode = 1;
+        return;
+    }
+    const matched = attachRequests(samples, readLogs());
+    if (matched === 0) {
+        console.log(`No requests of these sessions in the Appium logs in ${logDir}; only client time is reported`);
+    }
+    const methods = splitByMethod(samples);
+    fs.writeFileSync(path.join(reportsDir, 'split-latency.json'), JSON.stringify({ layers: LAYERS, matched, methods }, null, 2));
+
+    console.log(`Command time per page-object method, ${matched} requests matched in the Appium logs`);
+    console.log('  (c client overhead, h HTTP transport, a Appium routing, p driver proxy, d device execution)');
+    Object.entries(methods)
+        .sort(([, a], [, b]) => b.total - a.total)
+        .forEach(([name, method]) => {
+            const parts = LAYERS.map((layer) => `${layer} ${method.layers[layer]}ms`).join(', ');
+            console.log(`  ${bar(method.layers, method.total).padEnd(40)} ${name}: ${method.total}ms in ${method.commands} commands (${parts})`);
+        });
+}
+
+main();
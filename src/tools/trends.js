@@ -0,0 +1,95 @@
+/**
+ * Finds significant shifts in the timings recorded by TrendService and writes a static HTML trend report.
+ *
+ * Usage: node src/tools/trends.js [--metric p95] [--store .perf/trends.ndjson] [--html reports/trends.html]
+ *                                 [--min-change 0.1] [--min-t 4]
+ *
+ * Every test, page-object step and command is one series per platform and device, with one value per run. A shift
+ * is the split of a series into two segments (of at least three runs each) whose means differ most by Welch's t
+ * test; it is reported when t and the relative change reach the thresholds, e.g.
+ * 'step CartPage.proceedToCheckout p95 +35% since build 1a2b3c4d5e6f (git 89abcde)'.
+ */
+const fs = require('fs');
+const path = require('path');
+const { readTrends, series, changepoint } = require('../utilities/trendStore');
+
+function option(name, fallback) {
+    const index = process.argv.indexOf(`--${name}`);
+    return index !== -1 && process.argv[index + 1] ? process.argv[index + 1] : fallback;
+}
+
+const metric = option('metric', 'p95');
+const storeFile = path.resolve(option('store', '.perf/trends.ndjson'));
+const htmlFile = path.resolve(option('html', 'reports/trends.html'));
+const thresholds = { minChange: Number(option('min-change', 0.1)), minT: Number(option('min-t', 4)) };
+
+function describe(entry, shift) {
+    const sign = shift.change > 0 ? '+' : '';
+    const where = [entry.platform, entry.device].filter(Boolean).join(' / ');
+    return `${entry.kind} ${entry.name} ${metric} ${sign}${Math.round(shift.change * 100)}% `
+        + `(${shift.before}ms → ${shift.after}ms) since build ${shift.point.build} (git ${shift.point.git}, run ${shift.point.run}) on ${where}`;
+}
+
+function escapeHtml(text) {
+    return String(text).replace(/[&<>"]/g, (char) => ({ '&': '&amp;', '<': '&lt;', '>': '&gt;', '"': '&quot;' }[char]));
+}
+
+/**
+ * Inline SVG line chart of a series, with the shift marked.
+ */
+function sparkline(points, shift, width = 320, height = 60) {
+    const values = points.map((point) => point.value);
+    const max = Math.max(...values, 1);
+    const x = (index) => (points.length > 1 ? (index / (points.length - 1)) * (width - 4) + 2 : width / 2);
+    const y = (value) => height - 2 - (value / max) * (height - 4);
+    const line = points.map((point, index) => `${x(index).toFixed(1)},${y(point.value).toFixed(1)}`).join(' ');
+    const marker = shift
+        ? `<line x1="${x(shift.index)}" x2="${x(shift.index)}" y1="0" y2="${height}" stroke="#d33" stroke-dasharray="3,3"/>`
+        : '';
+    const titles = points.map((point, index) => `<circle cx="${x(index).toFixed(1)}" cy="${y(point.value).toFixed(1)}" r="2">`
+        + `<title>${escapeHtml(`${point.run} build ${point.build} git ${point.git}: ${point.value}ms`)}</title></circle>`).join('');
+    return `<svg width="${width}" height="${height}">${marker}<polyline fill="none" stroke="#36c" points="${line}"/>${titles}</svg>`;
+}
+
+function html(entries) {
+    const rows = entries.map(({ entry, shift }) => `<tr class="${shift ? 'shift' : ''}">
+<td>${escapeHtml(entry.kind)}</td><td>${escapeHtml(entry.name)}</td><td>${escapeHtml(entry.platform)}<br>${escapeHtml(entry.device || '')}</td>
+<td>${entry.points[entry.points.length - 1].value}ms</td>
+<td>${shift ? `${shift.change > 0 ? '+' : ''}${Math.round(shift.change * 100)}% since build ${escapeHtml(shift.point.build)}` : ''}</td>
+<td>${sparkline(entry.points, shift)}</td></tr>`).join('\n');
+    return `<!DOCTYPE html>
+<html><head><meta charset="utf-8"><title>Performance trends (${metric})</title>
+<style>
+body { font-family: sans-serif; margin: 2em; }
+table { border-collapse: collapse; }
+td, th { border-bottom: 1px solid #ddd; padding: 4px 8px; text-align: left; vertical-align: middle; }
+tr.shift td { background: #fff3f3; }
+</style></head><body>
+<h1>Performance trends (${metric})</h1>
+<p>Generated ${new Date().toISOString()} from ${escapeHtml(storeFile)}. Red dashed lines mark significant shifts.</p>
+<table><tr><th>Kind</th><th>Name</th><th>Platform</th><th>Latest</th><th>Shift</th><th>Runs</th></tr>
+${rows}
+</table></body></html>
+`;
+}
+
+function main() {
+    const rows = readTrends(storeFile);
+    if (rows.length === 0) {
+        console.log(`No trend data in ${storeFile}; runs record it through TrendService`);
+        return;
+    }
+    const entries = [...series(rows, metric).values()]
+        .map((entry) => ({ entry, shift: changepoint(entry.points, thresholds) }))
+        .sort((a, b) => Math.abs(b.shift?.change || 0) - Math.abs(a.shift?.change || 0) || a.entry.name.localeCompare(b.entry.name));
+
+    const shifts = entries.filter(({ shift }) => shift);
+    console.log(`${entries.length} series, ${shifts.length} significant shifts in ${metric}:`);
+    shifts.forEach(({ entry, shift }) => console.log(`  ${describe(entry, shift)}`));
+
+    fs.mkdirSync(path.dirname(htmlFile), { recursive: true });
+    fs.writeFileSync(htmlFile, html(entries));
+    console.log(`Trend report: ${htmlFile}`);
+}
+
+main();
@@ -50,46 +50,101 @@ module.exports = class NavigationBarComponent {
             : $(`-ios class chain:${iosSelector}`); // iOS
     }
 
+    get selectors() {
+        return {
+            errorMsgFullName: driver.isAndroid
+                ? '[id="com.saucelabs.mydemoapp.android:id/fullNameErrorTV"]' // Android
+                : '-ios class chain:**/XCUIElementTypeStaticText[`name == "Please provide your full name."`]', // iOS
+            errorMsgAddressLine1: '[id="com.saucelabs.mydemoapp.android:id/address1ErrorTV"]', // Android
+            errorMsgCity: '[id="com.saucelabs.mydemoapp.android:id/cityErrorTV"]', // Android
+            errorMsgZipCode: '[id="com.saucelabs.mydemoapp.android:id/zipErrorTV"]', // Android
+            errorMsgCountry: '[id="com.saucelabs.mydemoapp.android:id/countryErrorTV"]', // Android
+        };
+    }
+
     get errorMsgFullName() {
-        const iosSelector = '**/XCUIElementTypeStaticText[`name == "Please provide your full name."`]';
-        return driver.isAndroid
-            ? $('[id="com.saucelabs.mydemoapp.android:id/fullNameErrorTV"]') // Android
-            : $(`-ios class chain:${iosSelector}`); // iOS
+        return $(this.selectors.errorMsgFullName);
     }
 
     get errorMsgAddressLine1() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/address1ErrorTV"]') // Android
+        return $(this.selectors.errorMsgAddressLine1);
     }
 
     get errorMsgCity() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/cityErrorTV"]'); // Android
+        return $(this.selectors.errorMsgCity);
     }
 
     get errorMsgZipCode() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/zipErrorTV"]'); // Android
+        return $(this.selectors.errorMsgZipCode);
     }
 
     get errorMsgCountry() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/countryErrorTV"]'); // Android
+        return $(this.selectors.errorMsgCountry);
+    }
+
+    /**
+     * Maps user data onto the address form fields.
+     * @param {Object} userData - user data to be entered into Shipping/Billing Address form.
+     * @returns {Object} field getter name → value.
+     */
+    addressFields(userData) {
+        return {
+            fullNameInput: userData.name,
+            addressLine1Input: userData.billingAddress,
+            cityInput: userData.billingCity,
+            stateInput: userData.billingState,
+            zipCodeInput: userData.billingZipCode,
+            countryInput: userData.country,
+        };
+    }
+
+    /**
+     * Fills several fields in as few round trips as possible. Fields are looked up one at a time, as a single
+     * Appium session serves one command at a time anyway. On Android values are replaced driver-side with
+     * 'mobile: replaceElementValue' (no clear, no keyboard), while fields listed in typed, and every field on iOS,
+     * are typed with real key events, so the saving is Android-only. The keyboard is hidden afterwards on Android
+     * only; on iOS the callers keep typing into further fields and hide it themselves.
+     * @param {Object} values - field getter name → value.
+     * @param {Object} [options]
+     * @param {string[]} [options.typed=[]] - fields that need real key events on Android.
+     * @returns {void}
+     */
+    async fillForm(values, { typed = [] } = {}) {
+        let keyboardUsed = false;
+
+        for (const field of Object.keys(values)) {
+            let element = await this[field];
+            if (!element.elementId) {
+                await this[field].scrollIntoView();
+                element = await this[field];
+            }
+            if (driver.isAndroid && !typed.includes(field)) {
+                await driver.execute('mobile: replaceElementValue', { elementId: element.elementId, text: String(values[field]) });
+            } else {
+                await element.setValue(values[field]);
+                keyboardUsed = true;
+            }
+        }
+        if (keyboardUsed && driver.isAndroid) {
+            await browser.hideKeyboard();
+        }
     }
 
     /**
-     * Fills out the shipping/billing address form with valid user data on iOS.
+     * Fills out the shipping/billing address form with valid user data on iOS. Zip code and country are only
+     * reachable after moving focus, so they are typed after the first batch.
      * @param {Object} userData - user data to be entered into Shipping/Billing Address form.
      * @returns {void}
      */
     async populateFormIos(userData) {
-        await this.fullNameInput.setValue(userData.name);
-        await this.addressLine1Input.scrollIntoView();
-        await this.addressLine1Input.setValue(userData.billingAddress);
-        await this.cityInput.setValue(userData.billingCity);
-        await this.stateInput.setValue(userData.billingState);
+        const { zipCodeInput, countryInput, ...visibleFields } = this.addressFields(userData);
+        await this.fillForm(visibleFields);
         await this.addressLine2Input.click();
         await this.zipCodeInput.waitForDisplayed({timeout: 5000});
-        await this.zipCodeInput.setValue(userData.billingZipCode);
+        await this.zipCodeInput.setValue(zipCodeInput);
         await this.addressLine2Input.click();
         await this.countryInput.waitForDisplayed({timeout: 5000});
-        await this.countryInput.setValue(userData.country);
+        await this.countryInput.setValue(countryInput);
         await browser.hideKeyboard();
     }
 
@@ -99,14 +154,7 @@ module.exports = class NavigationBarComponent {
      * @returns {void}
      */
     async populateFormAndroid(userData) {
-        await this.fullNameInput.setValue(userData.name);
-        await this.addressLine1Input.scrollIntoView();
-        await this.addressLine1Input.setValue(userData.billingAddress);
-        await this.cityInput.setValue(userData.billingCity);
-        await this.stateInput.setValue(userData.billingState);
-        await this.zipCodeInput.setValue(userData.billingZipCode);
-        await this.countryInput.setValue(userData.country);
-        await browser.hideKeyboard();
+        await this.fillForm(this.addressFields(userData));
     }
 
 }
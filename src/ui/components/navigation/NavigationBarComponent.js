@@ -1,29 +1,29 @@
-const { $ } = require('@wdio/globals')
+const ElementCache = require('../../../utilities/ElementCache');
 
 class NavigationBarComponent {
     get catalogTabBtn() {
         const androidSelector = 'new UiSelector().text("Catalog")';
         return driver.isAndroid
-            ? $(`android=${androidSelector}`) // Android
-            : $('~Catalog-tab-item'); // iOS
+            ? ElementCache.$(`android=${androidSelector}`, { pinned: true }) // Android
+            : ElementCache.$('~Catalog-tab-item', { pinned: true }); // iOS
     }
 
     get cartTabBtn() {
         return driver.isAndroid
-            ? $('~Displays number of items in your cart') // Android
-            : $('~Cart-tab-item'); // iOS
+            ? ElementCache.$('~Displays number of items in your cart', { pinned: true }) // Android
+            : ElementCache.$('~Cart-tab-item', { pinned: true }); // iOS
     }
 
     get menuTabBtn() {
         return driver.isAndroid
-            ? $('~View menu') // Android
-            : $('~More-tab-item'); // iOS
+            ? ElementCache.$('~View menu', { pinned: true }) // Android
+            : ElementCache.$('~More-tab-item', { pinned: true }); // iOS
     }
 
     get appLogo() {
         return driver.isAndroid
-            ? $('~App logo and name') //Android
-            : $('~AppTitle Icons'); // iOS
+            ? ElementCache.$('~App logo and name', { pinned: true }) //Android
+            : ElementCache.$('~AppTitle Icons', { pinned: true }); // iOS
     }
 
     /**
@@ -32,6 +32,7 @@ class NavigationBarComponent {
      */
     async openMenu() {
         await this.menuTabBtn.click();
+        ElementCache.enterScreen('menu');
     }
 
     /**
@@ -40,6 +41,7 @@ class NavigationBarComponent {
      */
     async openCart() {
         await this.cartTabBtn.click();
+        ElementCache.enterScreen('cart');
     }
 }
 
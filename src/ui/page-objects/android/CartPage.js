@@ -1,20 +1,22 @@
 const { $ } = require('@wdio/globals');
+const ElementCache = require('../../../utilities/ElementCache');
+const { tapRepeatedly } = require('../../../utilities/gestures');
 
 class CartPage {
     get proceedToCheckoutBtn() {
-        return $('~Confirms products for checkout');
+        return ElementCache.$('~Confirms products for checkout');
     }
 
     get quantityPlusBtn() {
-        return $('~Increase item quantity');
+        return ElementCache.$('~Increase item quantity');
     }
 
     get quantityMinusBtn() {
-        return $('~Decrease item quantity');
+        return ElementCache.$('~Decrease item quantity');
     }
 
     get removeItemBtn() {
-        return $('~Removes product from cart');
+        return ElementCache.$('~Removes product from cart');
     }
 
     get emptyCartText() {
@@ -40,6 +42,7 @@ class CartPage {
      */
     async proceedToCheckout() {
         await this.proceedToCheckoutBtn.click();
+        ElementCache.enterScreen('checkout');
     }
 
     /**
@@ -59,18 +62,17 @@ class CartPage {
     }
 
     /**
-     * Adds number of a particular item to cart. Iterates over loop that number of times to adds item.
+     * Adds number of a particular item to cart. Sends all taps on the plus button as one batched action.
      * @param {number} quantity - The number of the item to be added
      * @returns {void}
      */
     async addQuantityOfItem(quantity) {
-        for (let i = 0; i < quantity; i++) {
-            await this.quantityPlusBtn.click();
-        }
+        await tapRepeatedly(this.quantityPlusBtn, quantity);
     }
 
     async removeItem() {
         await this.removeItemBtn.click();
+        ElementCache.enterScreen('cart');
     }
 }
 
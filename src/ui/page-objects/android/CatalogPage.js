@@ -6,6 +6,25 @@ class CatalogPage {
         return $(`android=${androidSelector}`);
     }
 
+    get productList() {
+        return $('android=new UiSelector().scrollable(true)');
+    }
+
+    /**
+     * Scrolls the catalog from top to bottom with swipe gestures, so every product row is rendered.
+     * @param {number} [maxSwipes=10] - upper bound on swipes for catalogs that keep loading.
+     * @returns {void}
+     */
+    async scrollToEnd(maxSwipes = 10) {
+        const elementId = (await this.productList).elementId;
+        for (let swipe = 0; swipe < maxSwipes; swipe++) {
+            const canScrollMore = await driver.execute('mobile: scrollGesture', { elementId, direction: 'down', percent: 1.0 });
+            if (!canScrollMore) {
+                break;
+            }
+        }
+    }
+
     /**
      * Selects the backpack item from the catalog.
      * @returns {void}
@@ -1,8 +1,16 @@
 const { $ } = require('@wdio/globals');
+const MacroClient = require('../../../utilities/MacroClient');
 
 class LoginPage {
+    get selectors() {
+        return {
+            validAccount: '[id="com.saucelabs.mydemoapp.android:id/username1TV"]',
+            btnSubmit: '[id="com.saucelabs.mydemoapp.android:id/buttonLL"]',
+        };
+    }
+
     get validAccount () {
-        return $('[id="com.saucelabs.mydemoapp.android:id/username1TV"]')
+        return $(this.selectors.validAccount);
     }
 
     get lockedAccount () {
@@ -24,16 +32,22 @@ class LoginPage {
     }
 
     get btnSubmit () {
-        return $('[id="com.saucelabs.mydemoapp.android:id/buttonLL"]');
+        return $(this.selectors.btnSubmit);
     }
 
     /**
-     * Logs in with valid credentials by selecting an account from the login page.
+     * Logs in with valid credentials by selecting an account from the login page, as a single macro request
+     * when the Appium macro plugin is enabled.
      * @returns {void}
      */
     async validLogin () {
-        await this.validAccount.click();
-        await this.btnSubmit.click();
+        await MacroClient.runOr([
+            MacroClient.step(this.selectors.validAccount, 'click'),
+            MacroClient.step(this.selectors.btnSubmit, 'click'),
+        ], async () => {
+            await this.validAccount.click();
+            await this.btnSubmit.click();
+        });
     }
 
     /**
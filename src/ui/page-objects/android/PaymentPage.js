@@ -1,21 +1,22 @@
 const { $ } = require('@wdio/globals');
 const ShippingBillingAddressForm = require('../../components/forms/ShippingBillingAddressForm');
+const MacroClient = require('../../../utilities/MacroClient');
 
 class PaymentPage extends ShippingBillingAddressForm {
     get cardNameInput() {
-        return  $('[id="com.saucelabs.mydemoapp.android:id/nameET"]');
+        return $(this.selectors.cardNameInput);
     }
 
     get cardNumberInput() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/cardNumberET"]');
+        return $(this.selectors.cardNumberInput);
     }
 
     get expirationDateInput() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/expirationDateET"]');
+        return $(this.selectors.expirationDateInput);
     }
 
     get securityCodeInput() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/securityCodeET"]');
+        return $(this.selectors.securityCodeInput);
     }
 
     get billingShippingSameChkBx() {
@@ -26,32 +27,54 @@ class PaymentPage extends ShippingBillingAddressForm {
         return $('~Saves payment info and launches screen to review checkout data');
     }
 
+    get selectors() {
+        return {
+            ...super.selectors,
+            cardNameInput: '[id="com.saucelabs.mydemoapp.android:id/nameET"]',
+            cardNumberInput: '[id="com.saucelabs.mydemoapp.android:id/cardNumberET"]',
+            expirationDateInput: '[id="com.saucelabs.mydemoapp.android:id/expirationDateET"]',
+            securityCodeInput: '[id="com.saucelabs.mydemoapp.android:id/securityCodeET"]',
+            errorMsgCardName: '[id="com.saucelabs.mydemoapp.android:id/nameErrorTV"]',
+            cardNumberErrorIcon: '[id="com.saucelabs.mydemoapp.android:id/cardNumberErrorIV"]',
+            errorMsgExpirationDate: '[id="com.saucelabs.mydemoapp.android:id/expirationDateErrorTV"]',
+            errorMsgSecurityCode: '[id="com.saucelabs.mydemoapp.android:id/securityCodeErrorTV"]',
+        };
+    }
+
     get errorMsgCardName() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/nameErrorTV"]');
+        return $(this.selectors.errorMsgCardName);
     }
 
     get cardNumberErrorIcon() {
-        return  $('[id="com.saucelabs.mydemoapp.android:id/cardNumberErrorIV"]');
+        return $(this.selectors.cardNumberErrorIcon);
     }
 
     get errorMsgExpirationDate() {
-        return  $('[id="com.saucelabs.mydemoapp.android:id/expirationDateErrorTV"]');
+        return $(this.selectors.errorMsgExpirationDate);
     }
 
     get errorMsgSecurityCode() {
-        return $('[id="com.saucelabs.mydemoapp.android:id/securityCodeErrorTV"]');
+        return $(this.selectors.errorMsgSecurityCode);
     }
 
     /**
-     * Fills out the payment information form with valid user data.
+     * Fills out the payment information form with valid user data, as a single macro request when the Appium
+     * macro plugin is enabled.
      * @param {Object} userData - user data to be entered into Shipping/Billing Address form.
      * @returns {void}
      */
     async enterPaymentInfo(userData) {
-        await this.cardNameInput.setValue(userData.name);
-        await this.cardNumberInput.setValue(userData.cardNumber);
-        await this.expirationDateInput.setValue(userData.expirationDate);
-        await this.securityCodeInput.setValue(userData.securityCode);
+        await MacroClient.runOr([
+            MacroClient.step(this.selectors.cardNameInput, 'setValue', { text: userData.name }),
+            MacroClient.step(this.selectors.cardNumberInput, 'setValue', { text: userData.cardNumber }),
+            MacroClient.step(this.selectors.expirationDateInput, 'setValue', { text: userData.expirationDate }),
+            MacroClient.step(this.selectors.securityCodeInput, 'setValue', { text: userData.securityCode }),
+        ], async () => {
+            await this.cardNameInput.setValue(userData.name);
+            await this.cardNumberInput.setValue(userData.cardNumber);
+            await this.expirationDateInput.setValue(userData.expirationDate);
+            await this.securityCodeInput.setValue(userData.securityCode);
+        });
     }
 
     /**
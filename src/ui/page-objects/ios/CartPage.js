@@ -1,21 +1,23 @@
 const { $ } = require('@wdio/globals');
+const ElementCache = require('../../../utilities/ElementCache');
+const { tapRepeatedly } = require('../../../utilities/gestures');
 
 class CartPage {
     get proceedToCheckoutBtn() {
-        return $('~ProceedToCheckout');
+        return ElementCache.$('~ProceedToCheckout');
     }
 
     get quantityPlusBtn() {
-        return $('~AddPlus Icons');
+        return ElementCache.$('~AddPlus Icons');
     }
 
     get quantityMinusBtn() {
-        return $('~SubtractMinus Icons');
+        return ElementCache.$('~SubtractMinus Icons');
     }
 
     get removeItemBtn() {
         const selector = '**/XCUIElementTypeStaticText[`name == "Remove Item"`]';
-        return $(`-ios class chain:${selector}`);
+        return ElementCache.$(`-ios class chain:${selector}`);
     }
 
     get emptyCartText() {
@@ -43,6 +45,7 @@ class CartPage {
      */
     async proceedToCheckout() {
         await this.proceedToCheckoutBtn.click();
+        ElementCache.enterScreen('checkout');
     }
 
     /**
@@ -62,14 +65,12 @@ class CartPage {
     }
 
     /**
-     * Adds number of a particular item to cart. Iterates over loop that number of times to adds item.
+     * Adds number of a particular item to cart. Sends all taps on the plus button as one batched action.
      * @param {number} quantity - The number of the item to be added
      * @returns {void}
      */
     async addQuantityOfItem(quantity) {
-        for (let i = 0; i < quantity; i++) {
-            await this.quantityPlusBtn.click();
-        }
+        await tapRepeatedly(this.quantityPlusBtn, quantity);
     }
 
     /**
@@ -78,6 +79,7 @@ class CartPage {
      */
     async removeItem() {
         await this.removeItemBtn.click();
+        ElementCache.enterScreen('cart');
     }
 }
 
@@ -1,9 +1,16 @@
 const { $ } = require('@wdio/globals');
+const MacroClient = require('../../../utilities/MacroClient');
 
 class LoginPage {
+    get selectors() {
+        return {
+            validAccount: '-ios class chain:**/XCUIElementTypeButton[`name == "bob@example.com"`]',
+            btnSubmit: 'button[name="Login"]',
+        };
+    }
+
     get validAccount () {
-        const selector = '**/XCUIElementTypeButton[`name == "bob@example.com"`]';
-        return $(`-ios class chain:${selector}`);
+        return $(this.selectors.validAccount);
     }
 
     get passwordRequiredErrorMessage() {
@@ -19,16 +26,22 @@ class LoginPage {
     }
 
     get btnSubmit () {
-        return $('button[name="Login"]');
+        return $(this.selectors.btnSubmit);
     }
 
     /**
-     * Logs in with valid credentials by selecting an account from the login page.
+     * Logs in with valid credentials by selecting an account from the login page, as a single macro request
+     * when the Appium macro plugin is enabled.
      * @returns {void}
      */
     async validLogin () {
-        await this.validAccount.click();
-        await this.btnSubmit.click();
+        await MacroClient.runOr([
+            MacroClient.step(this.selectors.validAccount, 'click'),
+            MacroClient.step(this.selectors.btnSubmit, 'click'),
+        ], async () => {
+            await this.validAccount.click();
+            await this.btnSubmit.click();
+        });
     }
 
     /**
@@ -1,25 +1,33 @@
 const { $ } = require('@wdio/globals');
 const ShippingBillingAddressForm = require('../../components/forms/ShippingBillingAddressForm');
+const MacroClient = require('../../../utilities/MacroClient');
 
 class PaymentPage extends ShippingBillingAddressForm {
+    get selectors() {
+        return {
+            ...super.selectors,
+            cardNameInput: '-ios class chain:**/XCUIElementTypeTextField[`value == "Maxim Winter"`]',
+            cardNumberInput: '-ios class chain:**/XCUIElementTypeTextField[`value == "3258 1265 7568 7896"`]',
+            expirationDateInput: '-ios class chain:**/XCUIElementTypeTextField[`value == "03/25"`]',
+            securityCodeInput: '-ios class chain:**/XCUIElementTypeTextField[`value == "123"`]',
+            hideKeyboardBtn: '~Hide keyboard',
+        };
+    }
+
     get cardNameInput() {
-        const selector = '**/XCUIElementTypeTextField[`value == "Maxim Winter"`]';
-        return $(`-ios class chain:${selector}`);
+        return $(this.selectors.cardNameInput);
     }
 
     get cardNumberInput() {
-        const selector = '**/XCUIElementTypeTextField[`value == "3258 1265 7568 7896"`]';
-        return $(`-ios class chain:${selector}`);
+        return $(this.selectors.cardNumberInput);
     }
 
     get expirationDateInput() {
-        const selector = '**/XCUIElementTypeTextField[`value == "03/25"`]';
-        return $(`-ios class chain:${selector}`);
+        return $(this.selectors.expirationDateInput);
     }
 
     get securityCodeInput() {
-        const selector = '**/XCUIElementTypeTextField[`value == "123"`]';
-        return $(`-ios class chain:${selector}`);
+        return $(this.selectors.securityCodeInput);
     }
 
     get billingShippingSameChkBx() {
@@ -38,16 +46,25 @@ class PaymentPage extends ShippingBillingAddressForm {
     }
 
     /**
-     * Fills out the payment information form with valid user data.
+     * Fills out the payment information form with valid user data, as a single macro request when the Appium
+     * macro plugin is enabled.
      * @param {Object} userData - user data to be entered into Shipping/Billing Address form.
      * @returns {void}
      */
     async enterPaymentInfo(userData) {
-        await this.cardNameInput.setValue(userData.name);
-        await this.cardNumberInput.setValue(userData.cardNumber);
-        await this.expirationDateInput.setValue(userData.expirationDate);
-        await this.securityCodeInput.setValue(userData.securityCode);
-        await $('~Hide keyboard').click();
+        await MacroClient.runOr([
+            MacroClient.step(this.selectors.cardNameInput, 'setValue', { text: userData.name }),
+            MacroClient.step(this.selectors.cardNumberInput, 'setValue', { text: userData.cardNumber }),
+            MacroClient.step(this.selectors.expirationDateInput, 'setValue', { text: userData.expirationDate }),
+            MacroClient.step(this.selectors.securityCodeInput, 'setValue', { text: userData.securityCode }),
+            MacroClient.step(this.selectors.hideKeyboardBtn, 'click'),
+        ], async () => {
+            await this.cardNameInput.setValue(userData.name);
+            await this.cardNumberInput.setValue(userData.cardNumber);
+            await this.expirationDateInput.setValue(userData.expirationDate);
+            await this.securityCodeInput.setValue(userData.securityCode);
+            await $(this.selectors.hideKeyboardBtn).click();
+        });
     }
 
     /**
@@ -0,0 +1,69 @@
+const { shell, sessionSerial } = require('./adb');
+const { currentApp } = require('./app');
+
+/**
+ * How the app is put into the state each start type begins from.
+ */
+const PREPARE = {
+    // Process killed: 'am start' forks a new process and creates the launch activity.
+    cold: (serial, app) => shell(serial, 'am', 'force-stop', app.id),
+    // Process alive, activities finished by backing out of them.
+    warm: async (serial) => {
+        await shell(serial, 'input', 'keyevent', 'KEYCODE_BACK');
+        await shell(serial, 'input', 'keyevent', 'KEYCODE_BACK');
+    },
+    // Process and activities alive in the background.
+    hot: (serial) => shell(serial, 'input', 'keyevent', 'KEYCODE_HOME'),
+};
+
+/**
+ * Measures Android app start with 'am start -W': TotalTime and WaitTime as reported by the activity manager, and the
+ * time to first frame from the 'Displayed' lines logcat prints for the launch activity.
+ */
+class AppStart {
+    /**
+     * Starts the app once from the state of the given start type.
+     * @param {'cold'|'warm'|'hot'} type - start type.
+     * @param {Object} [options]
+     * @param {number} [options.settle=1500] - ms to wait after the previous start before preparing, so the app is idle.
+     * @returns {Promise<Object>} { type, launchState, totalTime, waitTime, firstFrame, displayed }.
+     */
+    async measure(type, { settle = 1500 } = {}) {
+        const serial = sessionSerial();
+        const app = currentApp();
+        await new Promise((resolve) => setTimeout(resolve, settle));
+        await PREPARE[type](serial, app);
+        await shell(serial, 'logcat', '-c');
+
+        const output = await shell(serial, 'am', 'start', '-W', '-n', `${app.id}/${app.activity}`);
+        const logcat = await shell(serial, 'logcat', '-d', '-s', 'ActivityTaskManager:I', 'ActivityManager:I');
+        const field = (name) => {
+            const match = output.match(new RegExp(`^${name}: (\\S+)`, 'm'));
+            return match ? (Number.isNaN(Number(match[1])) ? match[1] : Number(match[1])) : null;
+        };
+        const displayed = parseDisplayed(logcat, app.id);
+        return {
+            type,
+            launchState: field('LaunchState'),
+            totalTime: field('TotalTime'),
+            waitTime: field('WaitTime'),
+            firstFrame: displayed.length ? displayed[0].duration : null,
+            displayed,
+        };
+    }
+}
+
+/**
+ * Parses logcat lines such as 'Displayed com.example/.MainActivity for user 0: +1s234ms'.
+ * @param {string} logcat - logcat dump.
+ * @param {string} appPackage - package whose activities to keep.
+ * @returns {Array<{activity: string, duration: number}>} in log order.
+ */
+function parseDisplayed(logcat, appPackage) {
+    const pattern = /Displayed (\S+?)(?: for user \d+)?: \+(?:(\d+)s)?(\d+)ms/g;
+    return [...logcat.matchAll(pattern)]
+        .filter(([, activity]) => activity.startsWith(`${appPackage}/`))
+        .map(([, activity, seconds, millis]) => ({ activity, duration: Number(seconds || 0) * 1000 + Number(millis) }));
+}
+
+module.exports = new AppStart();
@@ -0,0 +1,210 @@
+const { $ } = require('@wdio/globals');
+const { adb, sessionSerial } = require('./adb');
+const { currentApp } = require('./app');
+const { sessionArtifact } = require('./appArtifact');
+const DeepLinkNavigator = require('./DeepLinkNavigator');
+const ElementCache = require('./ElementCache');
+const { summarize } = require('./stats');
+
+/**
+ * Reset strategies, listed from the cheapest expected cost to the most expensive. Strategies that
+ * do not clear app state (cart, login) are only picked when the caller asks for navigation only.
+ * Fallback strategies are tried last and are never dropped after failures, so a device where the
+ * cheaper strategies do not work (e.g. an iOS real device, where clearApp fails) can still be reset.
+ */
+const STRATEGIES = {
+    deepLink: {
+        platforms: ['android', 'ios'],
+        clearsState: false,
+        async run() {
+            await DeepLinkNavigator.openUrl(DeepLinkNavigator.url('catalog'));
+        },
+    },
+    clearData: {
+        platforms: ['android', 'ios'],
+        clearsState: true,
+        async run(app) {
+            if (driver.isAndroid) {
+                await driver.execute('mobile: clearApp', { appId: app.id });
+                await driver.execute('mobile: startActivity', { intent: `${app.id}/${app.activity}`, wait: true });
+                return;
+            }
+            // XCUITest clears the app container on simulators only; real devices fail here and escalate.
+            await driver.execute('mobile: terminateApp', { bundleId: app.id });
+            await driver.execute('mobile: clearApp', { bundleId: app.id });
+            await driver.execute('mobile: activateApp', { bundleId: app.id });
+        },
+    },
+    // Terminates and re-activates the app; cart and login survive, so it only serves navigation-only resets.
+    relaunch: {
+        platforms: ['android', 'ios'],
+        clearsState: false,
+        fallback: true,
+        async run() {
+            await driver.relaunchActiveApp();
+        },
+    },
+    snapshot: {
+        platforms: ['android'],
+        clearsState: true,
+        available: () => Boolean(process.env.RESET_SNAPSHOT),
+        requires: 'RESET_SNAPSHOT',
+        async run(app) {
+            await adb(sessionSerial(), ['emu', 'avd', 'snapshot', 'load', process.env.RESET_SNAPSHOT]);
+            await driver.activateApp(app.id);
+        },
+    },
+    // Removes and reinstalls the session's app artifact, which clears app state on every device type.
+    reinstall: {
+        platforms: ['android', 'ios'],
+        clearsState: true,
+        fallback: true,
+        available: () => Boolean(sessionArtifact()),
+        requires: 'the app artifact (appium:app)',
+        async run(app) {
+            await driver.terminateApp(app.id);
+            await driver.removeApp(app.id);
+            await driver.installApp(sessionArtifact());
+            await driver.activateApp(app.id);
+        },
+    },
+};
+
+class AppStateReset {
+    constructor() {
+        this.history = [];
+        this.failures = {};
+    }
+
+    get catalogProbe() {
+        return driver.isAndroid
+            ? $('android=new UiSelector().resourceId("com.saucelabs.mydemoapp.android:id/productIV").instance(0)') // Android
+            : $('~Catalog-tab-item'); // iOS
+    }
+
+    get cartBadge() {
+        return $('[id="com.saucelabs.mydemoapp.android:id/cartTV"]'); // Android
+    }
+
+    /**
+     * Resets the app to the catalog screen using the cheapest strategy that produces a verified clean state.
+     * Strategies are tried in order of their measured mean cost and escalate to the next one when a run
+     * fails or its result cannot be verified.
+     * @param {Object} [options]
+     * @param {boolean} [options.clean=true] - require cart and login state to be cleared, not just navigation.
+     * @param {string} [options.strategy] - force a specific strategy instead of choosing one.
+     * @returns {Promise<{strategy: string, duration: number}>} the strategy used and how long the reset took.
+     */
+    async reset({ clean = true, strategy } = {}) {
+        const candidates = strategy ? [strategy] : this.candidates(clean);
+        if (candidates.length === 0) {
+            throw new Error(`App state reset failed: no ${clean ? 'state-clearing ' : ''}strategy is left on this device `
+                + `(${this.unusable(clean).join('; ')})`);
+        }
+        const errors = [];
+
+        for (const name of candidates) {
+            const start = Date.now();
+            try {
+                await STRATEGIES[name].run(currentApp());
+                ElementCache.enterScreen('catalog');
+                if (await this.verify()) {
+                    const duration = Date.now() - start;
+                    this.history.push({ strategy: name, duration });
+                    return { strategy: name, duration };
+                }
+                errors.push(`${name}: state could not be verified`);
+            } catch (error) {
+                errors.push(`${name}: ${error.message}`);
+            }
+            this.failures[name] = (this.failures[name] || 0) + 1;
+        }
+
+        throw new Error(`App state reset failed:\n${errors.join('\n')}`);
+    }
+
+    /**
+     * Lists usable strategies for the current platform, cheapest first and fallbacks last. Strategies
+     * other than fallbacks that failed twice in this session are dropped, and measured means take
+     * precedence over the default ordering.
+     * @param {boolean} clean - whether the strategy must clear app state.
+     * @returns {string[]} strategy names.
+     */
+    candidates(clean) {
+        const order = Object.keys(STRATEGIES);
+        return order
+            .filter((name) => !this.unusableReason(name, clean))
+            .sort((a, b) => Boolean(STRATEGIES[a].fallback) - Boolean(STRATEGIES[b].fallback)
+                || this.expectedCost(a, order) - this.expectedCost(b, order));
+    }
+
+    /**
+     * Explains why each strategy that could serve the request on this platform is not a candidate.
+     * @param {boolean} clean - whether the strategy must clear app state.
+     * @returns {string[]} one '<name>: <reason>' line per excluded strategy.
+     */
+    unusable(clean) {
+        return Object.keys(STRATEGIES)
+            .map((name) => [name, this.unusableReason(name, clean)])
+            .filter(([, reason]) => reason && reason !== 'other platform' && reason !== 'keeps app state')
+            .map(([name, reason]) => `${name}: ${reason}`);
+    }
+
+    unusableReason(name, clean) {
+        const strategy = STRATEGIES[name];
+        if (!strategy.platforms.includes(driver.isAndroid ? 'android' : 'ios')) {
+            return 'other platform';
+        }
+        if (clean && !strategy.clearsState) {
+            return 'keeps app state';
+        }
+        if (strategy.available && !strategy.available()) {
+            return `needs ${strategy.requires}`;
+        }
+        if (!strategy.fallback && (this.failures[name] || 0) >= 2) {
+            return 'failed twice in this session';
+        }
+        return undefined;
+    }
+
+    expectedCost(name, order) {
+        const samples = this.durations(name);
+        return samples.length
+            ? samples.reduce((sum, value) => sum + value, 0) / samples.length
+            : order.indexOf(name) * 1000;
+    }
+
+    durations(name) {
+        return this.history.filter((entry) => entry.strategy === name).map((entry) => entry.duration);
+    }
+
+    /**
+     * Checks that the app shows the catalog and, on Android, that the cart badge is gone.
+     * @returns {Promise<boolean>} true when the reset produced a clean catalog screen.
+     */
+    async verify() {
+        try {
+            await this.catalogProbe.waitForDisplayed({ timeout: 5000 });
+        } catch (error) {
+            return false;
+        }
+        return driver.isAndroid ? !(await this.cartBadge.isExisting()) : true;
+    }
+
+    /**
+     * Summarizes reset durations per strategy for the current worker.
+     * @returns {Object} summary keyed by strategy name.
+     */
+    report() {
+        const report = {};
+        for (const name of Object.keys(STRATEGIES)) {
+            const samples = this.durations(name);
+            if (samples.length) {
+                report[name] = summarize(samples);
+            }
+        }
+        return report;
+    }
+}
+
+module.exports = new AppStateReset();
@@ -0,0 +1,130 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { shell, sessionSerial } = require('./adb');
+const { simctl, sessionUdid } = require('./simctl');
+const { currentApp, pageObject } = require('./app');
+const DeepLinkNavigator = require('./DeepLinkNavigator');
+
+const ANDROID_SEED_DIR = '/data/local/tmp/auth-seed';
+const ANDROID_DATA_DIRS = ['shared_prefs', 'databases', 'files'];
+
+/**
+ * Ways to put the app into a logged-in state, cheapest first. Each one is confirmed by probe().
+ */
+const STRATEGIES = {
+    appData: {
+        available: (session) => session.seeded,
+        async run(session) {
+            await session.restoreSeed();
+        },
+    },
+    ui: {
+        available: () => true,
+        async run(session) {
+            await DeepLinkNavigator.login();
+            await session.captureSeed();
+        },
+    },
+};
+
+class AuthSession {
+    constructor() {
+        this.seeded = false;
+        this.failures = {};
+    }
+
+    /**
+     * Puts the app into a logged-in state without going through the login UI when possible. The first
+     * call in a session logs in through the UI and captures the app data as a seed; later calls restore
+     * that seed. Login specs keep calling LoginPage directly.
+     * @returns {Promise<string>} name of the strategy that established the session.
+     */
+    async login() {
+        const errors = [];
+        for (const [name, strategy] of Object.entries(STRATEGIES)) {
+            if (!strategy.available(this) || (this.failures[name] || 0) >= 2) {
+                continue;
+            }
+            try {
+                await strategy.run(this);
+                if (await this.probe()) {
+                    return name;
+                }
+                errors.push(`${name}: logged-in state not detected`);
+            } catch (error) {
+                errors.push(`${name}: ${error.message}`);
+            }
+            this.failures[name] = (this.failures[name] || 0) + 1;
+        }
+        throw new Error(`Could not establish a logged-in session:\n${errors.join('\n')}`);
+    }
+
+    /**
+     * Single lookup confirming the session: the menu only offers logout to a logged-in user. The menu is
+     * left open because callers navigate away with a deep link right after.
+     * @returns {Promise<boolean>} true when the app shows the logout menu item.
+     */
+    async probe() {
+        const NavigationBar = require('../ui/components/navigation/NavigationBarComponent');
+        await NavigationBar.openMenu();
+        return pageObject('MenuPage').logoutBtn.isExisting();
+    }
+
+    /**
+     * Copies the logged-in app data aside so later sessions can be restored without the login UI.
+     * Android needs an emulator image with 'su' (Google APIs images); iOS needs a simulator.
+     * @returns {void}
+     */
+    async captureSeed() {
+        const app = currentApp();
+        try {
+            if (driver.isAndroid) {
+                const serial = sessionSerial();
+                const copies = ANDROID_DATA_DIRS
+                    .map((dir) => `[ -d /data/data/${app.id}/${dir} ] && cp -a /data/data/${app.id}/${dir} ${ANDROID_SEED_DIR}/`)
+                    .join('; ');
+                await shell(serial, 'am', 'force-stop', app.id);
+                await shell(serial, 'su', '0', 'sh', '-c', `'rm -rf ${ANDROID_SEED_DIR} && mkdir -p ${ANDROID_SEED_DIR}; ${copies}; true'`);
+                await driver.execute('mobile: startActivity', { intent: `${app.id}/${app.activity}`, wait: true });
+            } else {
+                const container = await simctl(['get_app_container', sessionUdid(), app.id, 'data']);
+                await driver.terminateApp(app.id);
+                fs.rmSync(this.iosSeedDir(app), { recursive: true, force: true });
+                fs.cpSync(path.join(container, 'Library', 'Preferences'), this.iosSeedDir(app), { recursive: true });
+                await driver.activateApp(app.id);
+            }
+            this.seeded = true;
+        } catch (error) {
+            // Later logins fall back to the UI; say why, as login() does for failed strategies.
+            console.warn(`AuthSession: appData: seed capture failed, later logins use the UI: ${error.message}`);
+            this.seeded = false;
+        }
+    }
+
+    /**
+     * Restores the captured app data and relaunches the app.
+     * @returns {void}
+     */
+    async restoreSeed() {
+        const app = currentApp();
+        if (driver.isAndroid) {
+            const serial = sessionSerial();
+            const restore = `cd ${ANDROID_SEED_DIR} && for d in *; do rm -rf /data/data/${app.id}/$d; cp -a $d /data/data/${app.id}/; done; restorecon -R /data/data/${app.id}`;
+            await shell(serial, 'am', 'force-stop', app.id);
+            await shell(serial, 'su', '0', 'sh', '-c', `'${restore}'`);
+            await driver.execute('mobile: startActivity', { intent: `${app.id}/${app.activity}`, wait: true });
+        } else {
+            const container = await simctl(['get_app_container', sessionUdid(), app.id, 'data']);
+            await driver.terminateApp(app.id);
+            fs.cpSync(this.iosSeedDir(app), path.join(container, 'Library', 'Preferences'), { recursive: true });
+            await driver.activateApp(app.id);
+        }
+    }
+
+    iosSeedDir(app) {
+        return path.join(os.tmpdir(), 'auth-seed', app.id);
+    }
+}
+
+module.exports = new AuthSession();
@@ -0,0 +1,141 @@
+const fs = require('fs');
+const path = require('path');
+const { summarize } = require('./stats');
+
+/**
+ * Runs named user journeys repeatedly and summarizes their durations per journey and per step. Each iteration
+ * starts with an untimed setup; warmup iterations are run but not recorded.
+ */
+class Benchmark {
+    constructor() {
+        this.journeys = {};
+        this.current = null;
+    }
+
+    /**
+     * Runs a journey setup + run times and records the timed part.
+     * @param {string} name - journey name, as used in the budgets file.
+     * @param {Object} options
+     * @param {Function} [options.setup] - untimed preparation before every iteration.
+     * @param {Function} options.run - timed journey; wrap its parts in step() for per-step numbers.
+     * @param {number} [options.iterations=10] - recorded iterations.
+     * @param {number} [options.warmup=1] - unrecorded iterations run first.
+     * @returns {Promise<void>}
+     */
+    async journey(name, { setup, run, iterations = 10, warmup = 1 }) {
+        for (let iteration = 0; iteration < warmup + iterations; iteration++) {
+            if (setup) {
+                await setup();
+            }
+            this.current = {};
+            const start = Date.now();
+            await run();
+            const total = Date.now() - start;
+            const steps = this.current;
+            this.current = null;
+            if (iteration >= warmup) {
+                this.record(name, total, steps);
+            }
+        }
+    }
+
+    /**
+     * Records one iteration of a journey measured elsewhere, e.g. a start time reported by the device.
+     * @param {string} name - journey name.
+     * @param {number} total - journey duration in ms.
+     * @param {Object} [steps] - step name → duration in ms; null durations are skipped.
+     * @returns {void}
+     */
+    record(name, total, steps = {}) {
+        if (!Number.isFinite(total)) {
+            throw new Error(`Benchmark ${name}: total duration must be a number, got ${total}`);
+        }
+        const journey = this.journeys[name] = this.journeys[name] || { totals: [], steps: {} };
+        journey.totals.push(total);
+        for (const [step, duration] of Object.entries(steps)) {
+            if (duration !== null && duration !== undefined) {
+                (journey.steps[step] = journey.steps[step] || []).push(duration);
+            }
+        }
+    }
+
+    /**
+     * Times one step of the running journey.
+     * @param {string} name - step name, e.g. 'LoginPage.validLogin'.
+     * @param {Function} fn - async function to time.
+     * @returns {Promise<*>} result of fn.
+     */
+    async step(name, fn) {
+        const start = Date.now();
+        try {
+            return await fn();
+        } finally {
+            if (this.current) {
+                this.current[name] = (this.current[name] || 0) + (Date.now() - start);
+            }
+        }
+    }
+
+    /**
+     * Summaries of every journey and its steps.
+     * @returns {Object} { journey: { ...summary, steps: { step: summary } } }.
+     */
+    report() {
+        return Object.fromEntries(Object.entries(this.journeys).map(([name, journey]) => [name, {
+            ...summarize(journey.totals),
+            steps: Object.fromEntries(Object.entries(journey.steps).map(([step, durations]) => [step, summarize(durations)])),
+        }]));
+    }
+
+    /**
+     * Compares the results with budgets of the form { journeys: { login: { p50, p95, max, steps: { step: {...} } } } }.
+     * @param {Object} budgets - budgets of the platform.
+     * A budgeted journey or step without results fails as well, so a renamed step or a journey that never ran
+     * cannot pass unmeasured.
+     * @returns {string[]} one line per exceeded or unmeasured budget, empty when all are met.
+     */
+    exceeded(budgets) {
+        const report = this.report();
+        const failures = [];
+        const check = (label, summary, budget = {}) => {
+            if (!summary) {
+                failures.push(`${label} has a budget but no results`);
+                return;
+            }
+            for (const metric of ['p50', 'p95', 'max']) {
+                if (budget[metric] !== undefined && summary[metric] > budget[metric]) {
+                    failures.push(`${label} ${metric} ${summary[metric]}ms exceeds budget ${budget[metric]}ms`);
+                }
+            }
+        };
+        for (const [name, budget] of Object.entries(budgets.journeys || {})) {
+            check(name, report[name], budget);
+            if (!report[name]) {
+                continue;
+            }
+            for (const [step, stepBudget] of Object.entries(budget.steps || {})) {
+                check(`${name} → ${step}`, report[name]?.steps[step], stepBudget);
+            }
+        }
+        return failures;
+    }
+
+    /**
+     * Prints the results and writes them as JSON.
+     * @param {string} file - output path.
+     * @returns {void}
+     */
+    write(file) {
+        const report = this.report();
+        fs.mkdirSync(path.dirname(file), { recursive: true });
+        fs.writeFileSync(file, JSON.stringify(report, null, 2));
+        for (const [name, journey] of Object.entries(report)) {
+            console.log(`Journey ${name}: ${journey.count} runs, p50 ${journey.p50}ms, p95 ${journey.p95}ms, max ${journey.max}ms`);
+            for (const [step, summary] of Object.entries(journey.steps)) {
+                console.log(`  ${step}: p50 ${summary.p50}ms, p95 ${summary.p95}ms, max ${summary.max}ms`);
+            }
+        }
+    }
+}
+
+module.exports = new Benchmark();
@@ -0,0 +1,37 @@
+const { pageObject } = require('./app');
+const DeepLinkNavigator = require('./DeepLinkNavigator');
+const { tapRepeatedly } = require('./gestures');
+
+class CartSeeder {
+    /**
+     * Puts a number of units of a catalog item into the cart and leaves the app on the cart screen.
+     * @param {string} product - product key from data/deepLinks.js, e.g. 'backpack'.
+     * @param {number} amount - number of units.
+     * @param {Object} [options]
+     * @param {string} [options.mode='deepLink'] - 'deepLink' seeds the cart with one intent; 'batchedTaps' adds
+     *     the item through the UI and sends the remaining plus taps as one W3C action; 'clickLoop' clicks once per unit.
+     * @returns {void}
+     */
+    async seed(product, amount, { mode = 'deepLink' } = {}) {
+        if (mode === 'deepLink') {
+            return DeepLinkNavigator.open('cart', { cart: [{ product, amount }] });
+        }
+
+        await DeepLinkNavigator.open('product', { product });
+        await pageObject('ProductPage').addItemToCart();
+        await require('../ui/components/navigation/NavigationBarComponent').openCart();
+
+        const CartPage = pageObject('CartPage');
+        if (mode === 'batchedTaps') {
+            await tapRepeatedly(CartPage.quantityPlusBtn, amount - 1);
+        } else if (mode === 'clickLoop') {
+            for (let i = 1; i < amount; i++) {
+                await CartPage.quantityPlusBtn.click();
+            }
+        } else {
+            throw new Error(`Unknown cart seeding mode "${mode}"`);
+        }
+    }
+}
+
+module.exports = new CartSeeder();
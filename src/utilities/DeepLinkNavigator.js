@@ -0,0 +1,137 @@
+const deepLinks = require('../data/deepLinks');
+const { currentApp, pageObject } = require('./app');
+const ElementCache = require('./ElementCache');
+
+const SCREEN_ORDER = ['catalog', 'product', 'cart', 'checkout', 'payment'];
+
+class DeepLinkNavigator {
+    /**
+     * Builds the URL for a route, filling in {placeholders} from params.
+     * @param {string} route - route name from data/deepLinks.js.
+     * @param {Object} [params] - values for the route placeholders.
+     * @returns {string} deep link URL.
+     */
+    url(route, params = {}) {
+        const platform = driver.isAndroid ? 'android' : 'ios';
+        const template = deepLinks[platform][route] || deepLinks.routes[route];
+        if (!template) {
+            throw new Error(`No deep link route for "${route}"`);
+        }
+        return deepLinks.scheme + template.replace(/\{(\w+)\}/g, (match, key) => params[key]);
+    }
+
+    /**
+     * Fires a deep link intent at the app under test.
+     * @param {string} url - deep link URL.
+     * @returns {void}
+     */
+    async openUrl(url) {
+        const app = currentApp();
+        await driver.execute('mobile: deepLink', driver.isAndroid
+            ? { url, package: app.id }
+            : { url, bundleId: app.id });
+        ElementCache.enterScreen();
+    }
+
+    /**
+     * Lands directly on a screen with the requested cart and login state.
+     * @param {string} screen - one of catalog, product, cart, checkout, payment.
+     * @param {Object} [state]
+     * @param {boolean} [state.loggedIn=false] - establish a logged-in session (see AuthSession) before landing on the screen.
+     * @param {Array<{product: string, amount: number}>} [state.cart=[]] - cart contents to seed.
+     * @param {string} [state.product='backpack'] - product shown when the target screen is product.
+     * @param {Object} [state.userData] - address data, required when reaching payment through the UI.
+     * @param {boolean} [state.viaUi=false] - replay the UI journey instead of using deep links.
+     * @returns {void}
+     */
+    async open(screen, state = {}) {
+        if (!SCREEN_ORDER.includes(screen)) {
+            throw new Error(`Unknown screen "${screen}"`);
+        }
+        const { loggedIn = false, cart = [], product = 'backpack', viaUi = false } = state;
+
+        if (viaUi) {
+            return this.journey(screen, state);
+        }
+        if (loggedIn) {
+            await require('./AuthSession').login();
+        }
+        if (cart.length && screen !== 'cart') {
+            await this.openUrl(this.url('cart', { items: this.cartItems(cart) }));
+        }
+        await this.openUrl(this.url(screen, {
+            id: deepLinks.products[product].id,
+            items: this.cartItems(cart),
+        }));
+        await this.landmark(screen).waitForDisplayed();
+        ElementCache.enterScreen(screen);
+    }
+
+    /**
+     * Logs in through the menu and login page.
+     * @returns {void}
+     */
+    async login() {
+        const NavigationBar = require('../ui/components/navigation/NavigationBarComponent');
+        await NavigationBar.openMenu();
+        await pageObject('MenuPage').clickLoginBtn();
+        await pageObject('LoginPage').validLogin();
+    }
+
+    /**
+     * Replays the UI journey to the target screen. Kept for the tests that cover the journey itself.
+     * @param {string} screen - target screen.
+     * @param {Object} state - same as open().
+     * @returns {void}
+     */
+    async journey(screen, { loggedIn = false, cart = [], userData } = {}) {
+        const NavigationBar = require('../ui/components/navigation/NavigationBarComponent');
+        const target = SCREEN_ORDER.indexOf(screen);
+        const item = cart[0] || { product: 'backpack', amount: 1 };
+        if (cart.length > 1 || item.product !== 'backpack') {
+            throw new Error('The UI journey can only seed the backpack');
+        }
+
+        if (loggedIn) {
+            await this.login();
+        }
+        if (target >= SCREEN_ORDER.indexOf('product')) {
+            await pageObject('CatalogPage').selectBackpack();
+        }
+        if (target >= SCREEN_ORDER.indexOf('cart')) {
+            await pageObject('ProductPage').addItemToCart();
+            await NavigationBar.openCart();
+            await pageObject('CartPage').addQuantityOfItem(item.amount - 1);
+        }
+        if (target >= SCREEN_ORDER.indexOf('checkout')) {
+            await pageObject('CartPage').proceedToCheckout();
+        }
+        if (target >= SCREEN_ORDER.indexOf('payment')) {
+            const CheckoutPage = pageObject('CheckoutPage');
+            await (driver.isAndroid
+                ? CheckoutPage.enterShippingAddressAndroid(userData)
+                : CheckoutPage.enterShippingAddressIos(userData));
+        }
+    }
+
+    cartItems(cart) {
+        return cart.map(({ product, amount }) => `id=${deepLinks.products[product].id}&amount=${amount}`).join(',');
+    }
+
+    /**
+     * Returns an element that is only displayed once the given screen has loaded.
+     * @param {string} screen - target screen.
+     * @returns {WebdriverIO.Element} chainable element.
+     */
+    landmark(screen) {
+        switch (screen) {
+            case 'catalog': return pageObject('CatalogPage').backpackItem;
+            case 'product': return pageObject('ProductPage').addToCartBtn;
+            case 'cart': return pageObject('CartPage').proceedToCheckoutBtn;
+            case 'checkout': return pageObject('CheckoutPage').toPaymentBtn;
+            case 'payment': return pageObject('PaymentPage').reviewOrderBtn;
+        }
+    }
+}
+
+module.exports = new DeepLinkNavigator();
@@ -0,0 +1,90 @@
+const { $ } = require('@wdio/globals');
+
+/**
+ * Keeps resolved elements for page-object getters so repeated access on the same screen skips the
+ * find-element round trip. Entries belong to the current screen and are dropped by enterScreen();
+ * pinned entries (static chrome such as the navigation bar) live for the whole session. Cached
+ * elements keep their selector, so WebdriverIO can still refetch them after a stale element error.
+ */
+class ElementCache {
+    constructor() {
+        this.entries = new Map();
+        this.screen = null;
+        this.sessionId = null;
+        this.hits = 0;
+        this.misses = 0;
+        this.invalidations = 0;
+    }
+
+    /**
+     * Returns the cached element for a selector, or queries it and caches the result.
+     * @param {string} selector - WebdriverIO selector.
+     * @param {Object} [options]
+     * @param {boolean} [options.pinned=false] - keep the element across screens and tests for the session.
+     * @returns {WebdriverIO.Element|ChainablePromiseElement} element usable like the result of $().
+     */
+    $(selector, { pinned = false } = {}) {
+        if (this.sessionId !== driver.sessionId) {
+            this.entries.clear();
+            this.sessionId = driver.sessionId;
+        }
+
+        const entry = this.entries.get(selector);
+        if (entry && (entry.pinned || entry.screen === this.screen)) {
+            this.hits++;
+            return entry.element;
+        }
+
+        this.misses++;
+        const screen = this.screen;
+        const element = $(selector);
+        element.then((resolved) => {
+            if (resolved.elementId && this.screen === screen) {
+                this.entries.set(selector, { element: resolved, screen, pinned });
+            }
+        }, () => {});
+        return element;
+    }
+
+    /**
+     * Marks a screen change and drops every entry that is not pinned.
+     * @param {string} [screen] - name of the screen the app is now on.
+     * @returns {void}
+     */
+    enterScreen(screen = null) {
+        this.screen = screen;
+        for (const [selector, entry] of this.entries) {
+            if (!entry.pinned) {
+                this.entries.delete(selector);
+            }
+        }
+    }
+
+    /**
+     * Drops all screen entries after a stale element error. Meant for the afterCommand hook.
+     * @param {Error} [error] - error returned by the command, if any.
+     * @returns {void}
+     */
+    handleCommandError(error) {
+        if (error && /stale element/i.test(`${error.name} ${error.message}`)) {
+            this.invalidations++;
+            this.enterScreen(this.screen);
+        }
+    }
+
+    /**
+     * Hit and miss counters for the current worker.
+     * @returns {{hits: number, misses: number, hitRate: number, invalidations: number}} cache statistics.
+     */
+    stats() {
+        const total = this.hits + this.misses;
+        return {
+            hits: this.hits,
+            misses: this.misses,
+            hitRate: total ? this.hits / total : 0,
+            invalidations: this.invalidations,
+        };
+    }
+}
+
+module.exports = new ElementCache();
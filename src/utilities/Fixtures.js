@@ -0,0 +1,208 @@
+const fs = require('fs');
+const path = require('path');
+const { adb, shell, sessionSerial } = require('./adb');
+const { simctl, sessionUdid } = require('./simctl');
+const { currentApp } = require('./app');
+const { appHash, sessionArtifact } = require('./appArtifact');
+const AppStateReset = require('./AppStateReset');
+const DeepLinkNavigator = require('./DeepLinkNavigator');
+const { summarize } = require('./stats');
+
+const FIXTURE_DIR = path.resolve('.perf/fixtures');
+const INDEX_DIR = path.join(FIXTURE_DIR, 'index');
+const DEVICE_STAGING_DIR = '/data/local/tmp/fixtures';
+const MAX_RESTORE_FAILURES = 2;
+
+/**
+ * Ways to store a fixture, tagged with the hash of the app binary it was built from. App data restores the login,
+ * after which the screen (and the in-memory cart) are re-entered through deep links. Emulator snapshots are not
+ * used: they also restore the UiAutomator2 server and the driver state of the moment they were taken, and farm
+ * emulators run read-only.
+ */
+const KINDS = {
+    appData: {
+        available: () => true,
+        async capture(fixture) {
+            const app = currentApp();
+            const dir = path.join(FIXTURE_DIR, fixture.id);
+            fs.rmSync(dir, { recursive: true, force: true });
+            fs.mkdirSync(dir, { recursive: true });
+            if (driver.isAndroid) {
+                const serial = sessionSerial();
+                const staging = `${DEVICE_STAGING_DIR}/${fixture.id}`;
+                await shell(serial, 'am', 'force-stop', app.id);
+                await shell(serial, 'su', '0', 'sh', '-c', `'rm -rf ${staging} && mkdir -p ${staging} && cd /data/data/${app.id} && for d in *; do [ "$d" = cache ] || [ "$d" = lib ] || cp -a $d ${staging}/; done; chmod -R a+rX ${staging}'`);
+                await adb(serial, ['pull', `${staging}/.`, dir]);
+                await shell(serial, 'rm', '-rf', staging);
+                await driver.execute('mobile: startActivity', { intent: `${app.id}/${app.activity}`, wait: true });
+            } else {
+                const container = await simctl(['get_app_container', sessionUdid(), app.id, 'data']);
+                await driver.terminateApp(app.id);
+                for (const entry of ['Library', 'Documents'].filter((name) => fs.existsSync(path.join(container, name)))) {
+                    fs.cpSync(path.join(container, entry), path.join(dir, entry), { recursive: true });
+                }
+                await driver.activateApp(app.id);
+            }
+        },
+        async restore(fixture) {
+            const app = currentApp();
+            const dir = path.join(FIXTURE_DIR, fixture.id);
+            if (!fs.existsSync(dir)) {
+                throw new Error(`app data for fixture ${fixture.id} is missing`);
+            }
+            if (driver.isAndroid) {
+                const serial = sessionSerial();
+                const staging = `${DEVICE_STAGING_DIR}/${fixture.id}`;
+                await shell(serial, 'am', 'force-stop', app.id);
+                await adb(serial, ['push', `${dir}/.`, staging]);
+                await shell(serial, 'su', '0', 'sh', '-c', `'cd ${staging} && for d in *; do rm -rf /data/data/${app.id}/$d; cp -a $d /data/data/${app.id}/; done; chown -R $(stat -c %u /data/data/${app.id}):$(stat -c %g /data/data/${app.id}) /data/data/${app.id}; restorecon -R /data/data/${app.id}; rm -rf ${staging}'`);
+                await driver.execute('mobile: startActivity', { intent: `${app.id}/${app.activity}`, wait: true });
+            } else {
+                const container = await simctl(['get_app_container', sessionUdid(), app.id, 'data']);
+                await driver.terminateApp(app.id);
+                fs.cpSync(dir, container, { recursive: true });
+                await driver.activateApp(app.id);
+            }
+        },
+        async discard(fixture) {
+            fs.rmSync(path.join(FIXTURE_DIR, fixture.id), { recursive: true, force: true });
+        },
+    },
+};
+
+class Fixtures {
+    constructor() {
+        this.failures = {};
+        this.history = [];
+    }
+
+    /**
+     * Puts the app on a screen with the given state from a stored fixture, building and storing the fixture
+     * first when it is missing, was built from a different app binary, or fails to restore. When the app binary is
+     * unknown, or a fixture failed to restore twice in this worker, the state is built every time and nothing is
+     * stored.
+     * @param {string} screen - screen as accepted by DeepLinkNavigator.open().
+     * @param {Object} [state] - state as accepted by DeepLinkNavigator.open().
+     * @returns {Promise<{kind: string, built: boolean, duration: number}>} how the state was reached.
+     */
+    async restore(screen, state = {}) {
+        const start = Date.now();
+        const key = this.key(screen, state);
+        const tag = appHash(sessionArtifact());
+        if (!tag) {
+            // Without the app binary's hash a stored fixture could belong to any build, so none is used or stored.
+            await AppStateReset.reset();
+            await DeepLinkNavigator.open(screen, state);
+            return this.record(key, 'none', true, start);
+        }
+        if ((this.failures[key] || 0) >= MAX_RESTORE_FAILURES) {
+            // A fixture that keeps failing to restore is not rebuilt again in this worker; the state is built directly.
+            await AppStateReset.reset();
+            await DeepLinkNavigator.open(screen, state);
+            return this.record(key, 'none', true, start);
+        }
+        const fixture = readEntry(key);
+
+        if (fixture && fixture.tag === tag && KINDS[fixture.kind]) {
+            try {
+                await KINDS[fixture.kind].restore(fixture);
+                await this.enter(screen, state);
+                return this.record(key, fixture.kind, false, start);
+            } catch (error) {
+                this.failures[key] = (this.failures[key] || 0) + 1;
+                console.warn(`Fixture ${key} could not be restored (${error.message}), rebuilding`);
+            }
+        }
+        if (fixture && KINDS[fixture.kind]) {
+            await KINDS[fixture.kind].discard(fixture);
+        }
+
+        // Only the login is stored, so the screen is opened once, after the capture, whether it succeeded or not.
+        await AppStateReset.reset();
+        if (state.loggedIn) {
+            await require('./AuthSession').login();
+        }
+        const built = await this.capture(key, screen, tag);
+        await this.enter(screen, state);
+        return this.record(key, built ? built.kind : 'none', true, start);
+    }
+
+    /**
+     * Stores the current app state with the first kind that works on this device.
+     */
+    async capture(key, screen, tag) {
+        const id = `${key.replace(/[^\w-]+/g, '_')}-${tag.slice(0, 12)}`;
+        for (const [kind, implementation] of Object.entries(KINDS)) {
+            if (!implementation.available()) {
+                continue;
+            }
+            const fixture = { id, kind, tag, screen, createdAt: new Date().toISOString() };
+            try {
+                await implementation.capture(fixture);
+                writeEntry(key, fixture);
+                return fixture;
+            } catch (error) {
+                console.warn(`Fixture ${key}: ${kind} capture failed (${error.message})`);
+            }
+        }
+        return undefined;
+    }
+
+    /**
+     * Opens the screen and cart on top of the login restored or captured with the app data.
+     */
+    async enter(screen, state) {
+        await DeepLinkNavigator.open(screen, { ...state, loggedIn: false });
+    }
+
+    /**
+     * Fixtures are per platform and device (app data belongs to an app install).
+     */
+    key(screen, state) {
+        const device = driver.isAndroid ? sessionSerial() || 'android' : sessionUdid();
+        const cart = (state.cart || []).map(({ product, amount }) => `${product}x${amount}`).join('+');
+        return [driver.isAndroid ? 'android' : 'ios', device, screen, state.loggedIn ? 'loggedIn' : 'guest', cart || 'empty'].join('/');
+    }
+
+    record(key, kind, built, start) {
+        const entry = { key, kind, built, duration: Date.now() - start };
+        this.history.push(entry);
+        return entry;
+    }
+
+    /**
+     * Summarizes restore and build durations for the current worker.
+     * @returns {Object} summaries keyed 'restore' and 'build'.
+     */
+    report() {
+        const restores = this.history.filter((entry) => !entry.built).map((entry) => entry.duration);
+        const builds = this.history.filter((entry) => entry.built).map((entry) => entry.duration);
+        return {
+            ...(restores.length ? { restore: summarize(restores) } : {}),
+            ...(builds.length ? { build: summarize(builds) } : {}),
+        };
+    }
+}
+
+function entryFile(key) {
+    return path.join(INDEX_DIR, `${key.replace(/[^\w-]+/g, '_')}.json`);
+}
+
+function readEntry(key) {
+    const file = entryFile(key);
+    return fs.existsSync(file) ? JSON.parse(fs.readFileSync(file, 'utf8')) : undefined;
+}
+
+/**
+ * Writes one index entry per file through a temporary file and a rename, so workers storing fixtures at the same
+ * time neither overwrite each other's entries nor read a half-written one.
+ */
+function writeEntry(key, fixture) {
+    const file = entryFile(key);
+    const temporary = `${file}.${process.pid}.tmp`;
+    fs.mkdirSync(INDEX_DIR, { recursive: true });
+    fs.writeFileSync(temporary, JSON.stringify(fixture, null, 2));
+    fs.renameSync(temporary, file);
+}
+
+module.exports = new Fixtures();
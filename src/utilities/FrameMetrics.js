@@ -0,0 +1,88 @@
+const fs = require('fs');
+const path = require('path');
+const { shell, sessionSerial } = require('./adb');
+const { currentApp } = require('./app');
+
+const COUNTERS = {
+    totalFrames: /Total frames rendered: (\d+)/,
+    jankyFrames: /Janky frames: (\d+)/,
+    jankyPercent: /Janky frames: \d+ \(([\d.]+)%\)/,
+    p50: /50th percentile: (\d+)ms/,
+    p90: /90th percentile: (\d+)ms/,
+    p95: /95th percentile: (\d+)ms/,
+    p99: /99th percentile: (\d+)ms/,
+    missedVsync: /Number Missed Vsync: (\d+)/,
+    slowUiThread: /Number Slow UI thread: (\d+)/,
+    slowBitmapUploads: /Number Slow bitmap uploads: (\d+)/,
+    slowDrawCommands: /Number Slow issue draw commands: (\d+)/,
+    frameDeadlineMissed: /Number Frame deadline missed: (\d+)/,
+};
+
+/**
+ * Measures rendering smoothness of a block of test steps on Android from 'dumpsys gfxinfo': the app's frame
+ * statistics are reset before the block and read after it. Captures are attached to the running test and written
+ * with it by attach(). On iOS the block runs unmeasured.
+ */
+class FrameMetrics {
+    constructor() {
+        this.captures = [];
+        this.results = [];
+    }
+
+    /**
+     * Runs a block and returns the frame statistics of the app while it ran.
+     * @param {string} label - name of the block, e.g. 'catalog scroll'.
+     * @param {Function} block - async function to measure.
+     * @returns {Promise<Object|null>} { label, totalFrames, jankyFrames, jankyPercent, p50, p90, p95, p99, slowUiThread, ... },
+     *   or null when not on Android.
+     */
+    async capture(label, block) {
+        if (!driver.isAndroid) {
+            await block();
+            return null;
+        }
+        const serial = sessionSerial();
+        const app = currentApp();
+        await shell(serial, 'dumpsys', 'gfxinfo', app.id, 'reset');
+        await block();
+        const metrics = { label, ...parseGfxinfo(await shell(serial, 'dumpsys', 'gfxinfo', app.id)) };
+        this.captures.push(metrics);
+        return metrics;
+    }
+
+    /**
+     * Logs the captures of a finished test and writes them to ./reports/frame-metrics-<cid>.json.
+     * @param {Object} test - test object from the afterTest hook.
+     * @returns {void}
+     */
+    attach(test) {
+        if (this.captures.length === 0) {
+            return;
+        }
+        const title = test.fullTitle || test.title;
+        for (const capture of this.captures) {
+            console.log(`Frames during '${capture.label}' (${title}): ${capture.totalFrames} frames, ${capture.jankyPercent}% janky, `
+                + `p90 ${capture.p90}ms, p95 ${capture.p95}ms, p99 ${capture.p99}ms, ${capture.slowUiThread} slow UI thread`);
+        }
+        this.results.push({ test: title, file: test.file, captures: this.captures });
+        this.captures = [];
+
+        const file = path.resolve('reports', `frame-metrics-${process.env.WDIO_WORKER_ID || process.pid}.json`);
+        fs.mkdirSync(path.dirname(file), { recursive: true });
+        fs.writeFileSync(file, JSON.stringify(this.results, null, 2));
+    }
+}
+
+/**
+ * Reads the process-wide statistics (the first block of 'dumpsys gfxinfo <package>', before the per-window ones).
+ * @param {string} output - dumpsys output.
+ * @returns {Object} counters; missing ones are null.
+ */
+function parseGfxinfo(output) {
+    return Object.fromEntries(Object.entries(COUNTERS).map(([name, pattern]) => {
+        const match = output.match(pattern);
+        return [name, match ? Number(match[1]) : null];
+    }));
+}
+
+module.exports = new FrameMetrics();
@@ -0,0 +1,95 @@
+const { driverLocator } = require('./page-source/selectors');
+
+/**
+ * Client for the Appium macro plugin (src/appium-plugins/macro). Registers driver.runMacro(steps) and lets page
+ * objects run a flow as one request, falling back to their per-command implementation when the server has no
+ * macro endpoint (plugin not installed or enabled, or a replayed recording made without it).
+ */
+class MacroClient {
+    constructor() {
+        this.support = new Map();
+    }
+
+    /**
+     * Adds runMacro to the session. Called from the config's before hook.
+     * @param {Object} browser - WebdriverIO browser/driver instance.
+     * @returns {void}
+     */
+    register(browser) {
+        browser.addCommand('runMacro', (steps, options) => this.run(browser, steps, options));
+    }
+
+    /**
+     * Builds a step from a page-object selector.
+     * @param {string} selector - WebdriverIO selector, e.g. '~Login' or '-ios class chain:...'.
+     * @param {string} [action] - click, clear, setValue, text or waitForDisplayed; omit to only locate.
+     * @param {Object} [extra] - additional step fields such as text or assert.
+     * @returns {Object} macro step.
+     */
+    step(selector, action, extra = {}) {
+        return { ...driverLocator(selector, driver.isIOS ? 'ios' : 'android'), ...(action ? { action } : {}), ...extra };
+    }
+
+    /**
+     * Sends the steps to the server in one request.
+     * @param {Object} browser - WebdriverIO browser/driver instance.
+     * @param {Object[]} steps - macro steps.
+     * @param {Object} [options]
+     * @param {number} [options.timeout] - per-step locate timeout, defaults to waitforTimeout.
+     * @returns {Object} { steps: [{ index, action, elementId, result, duration }], duration }.
+     */
+    async run(browser, steps, { timeout = browser.options.waitforTimeout } = {}) {
+        const { protocol = 'http', hostname = 'localhost', port, path = '/' } = browser.options;
+        const base = `${protocol}://${hostname}:${port}${path.replace(/\/$/, '')}`;
+        const response = await fetch(`${base}/session/${browser.sessionId}/appium/macro`, {
+            method: 'POST',
+            headers: { 'Content-Type': 'application/json' },
+            body: JSON.stringify({ steps, timeout }),
+        });
+        // Servers without the plugin may answer the unknown route with a non-JSON 404 page.
+        const value = parseJson(await response.text())?.value;
+
+        if (response.status === 404 && (!value || ['unknown command', 'unknown method'].includes(value.error))) {
+            this.support.set(browser.sessionId, false);
+            const error = new Error('Macro endpoint not available');
+            error.unsupported = true;
+            throw error;
+        }
+        if (!response.ok) {
+            throw new Error(value?.message || `Macro failed with HTTP ${response.status}`);
+        }
+        this.support.set(browser.sessionId, true);
+        return value;
+    }
+
+    /**
+     * Runs the steps as a macro, or the fallback when the server does not support macros. Step failures are
+     * rethrown, not retried through the fallback.
+     * @param {Object[]} steps - macro steps.
+     * @param {function(): Promise} fallback - per-command implementation of the same flow.
+     * @returns {Object|*} macro result, or the fallback's result.
+     */
+    async runOr(steps, fallback) {
+        if (!driver.runMacro || this.support.get(driver.sessionId) === false) {
+            return fallback();
+        }
+        try {
+            return await driver.runMacro(steps);
+        } catch (error) {
+            if (error.unsupported) {
+                return fallback();
+            }
+            throw error;
+        }
+    }
+}
+
+function parseJson(text) {
+    try {
+        return JSON.parse(text);
+    } catch (error) {
+        return null;
+    }
+}
+
+module.exports = new MacroClient();
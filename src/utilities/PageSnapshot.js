@@ -0,0 +1,79 @@
+const { parseXml } = require('./page-source/parseXml');
+const { findAll } = require('./page-source/selectors');
+
+const POLL_INTERVAL = 500;
+
+/**
+ * Reads the text WebdriverIO's getText() would return for a page-source node.
+ * @param {Object} node - parsed node.
+ * @returns {string} element text.
+ */
+function textOf(node) {
+    return driver.isAndroid
+        ? node.attributes.text ?? ''
+        : node.attributes.label ?? node.attributes.value ?? node.attributes.name ?? '';
+}
+
+/**
+ * Reads whether a page-source node is displayed.
+ * @param {Object} node - parsed node.
+ * @returns {boolean} true when the driver reports the node as displayed.
+ */
+function isDisplayed(node) {
+    return (driver.isAndroid ? node.attributes.displayed : node.attributes.visible) === 'true';
+}
+
+class PageSnapshot {
+    /**
+     * Checks several element expectations against one page source instead of one lookup per element.
+     * A new page source is fetched only while some expectation still fails, until the timeout expires.
+     * @param {Array<{selector: string, text?: string, displayed?: boolean}>} expectations - selector plus text the
+     *     element must contain (like toHaveText with containing: true) and/or the expected displayed state.
+     * @param {Object} [options]
+     * @param {number} [options.timeout] - how long to keep refetching, defaults to waitforTimeout.
+     * @returns {void}
+     */
+    async expectAll(expectations, { timeout = browser.options.waitforTimeout } = {}) {
+        const deadline = Date.now() + timeout;
+        let failures;
+
+        for (;;) {
+            const document = parseXml(await driver.getPageSource());
+            failures = expectations
+                .map((expectation) => this.evaluate(document, expectation))
+                .filter(Boolean);
+            if (failures.length === 0) {
+                return;
+            }
+            const remaining = deadline - Date.now();
+            if (remaining <= 0) {
+                break;
+            }
+            await driver.pause(Math.min(POLL_INTERVAL, remaining));
+        }
+
+        throw new Error(`Page snapshot expectations failed:\n${failures.join('\n')}`);
+    }
+
+    /**
+     * Evaluates one expectation against a parsed page source.
+     * @param {Object} document - parsed page source.
+     * @param {Object} expectation - selector, text and/or displayed.
+     * @returns {string|null} failure description, or null when the expectation holds.
+     */
+    evaluate(document, { selector, text, displayed }) {
+        const [node] = findAll(document, selector, driver.isAndroid ? 'android' : 'ios');
+        if (!node) {
+            return `${selector}: element not found`;
+        }
+        if (text !== undefined && !textOf(node).includes(text)) {
+            return `${selector}: expected text containing "${text}" but found "${textOf(node)}"`;
+        }
+        if (displayed !== undefined && isDisplayed(node) !== displayed) {
+            return `${selector}: expected ${displayed ? '' : 'not '}to be displayed`;
+        }
+        return null;
+    }
+}
+
+module.exports = new PageSnapshot();
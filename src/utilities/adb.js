@@ -0,0 +1,45 @@
+const { execFile } = require('child_process');
+
+const ADB_TIMEOUT = 60000;
+
+/**
+ * Resolves the adb serial of the device the current session is running on.
+ * @returns {string|undefined} adb serial, or undefined when it cannot be determined.
+ */
+function sessionSerial() {
+    const caps = driver.capabilities || {};
+    return caps['appium:udid'] || caps.udid || caps.deviceUDID || process.env.ANDROID_SERIAL;
+}
+
+/**
+ * Runs an adb command on the host against a specific device.
+ * @param {string} serial - adb serial of the target device (undefined targets the only attached device).
+ * @param {string[]} args - arguments passed to adb after the serial.
+ * @param {Object} [options] - execFile options, e.g. timeout.
+ * @returns {Promise<string>} stdout of the adb command.
+ */
+function adb(serial, args, options = {}) {
+    const fullArgs = serial ? ['-s', serial, ...args] : args;
+    const binary = process.env.ANDROID_HOME ? `${process.env.ANDROID_HOME}/platform-tools/adb` : 'adb';
+    return new Promise((resolve, reject) => {
+        execFile(binary, fullArgs, { timeout: ADB_TIMEOUT, maxBuffer: 32 * 1024 * 1024, ...options }, (error, stdout, stderr) => {
+            if (error) {
+                error.message = `adb ${fullArgs.join(' ')} failed: ${stderr || error.message}`;
+                return reject(error);
+            }
+            resolve(stdout);
+        });
+    });
+}
+
+/**
+ * Runs a shell command on a device through adb.
+ * @param {string} serial - adb serial of the target device.
+ * @param {...string} args - shell command and its arguments.
+ * @returns {Promise<string>} stdout of the shell command.
+ */
+function shell(serial, ...args) {
+    return adb(serial, ['shell', ...args]);
+}
+
+module.exports = { adb, shell, sessionSerial };
@@ -0,0 +1,21 @@
+/**
+ * Reads the identity of the app under test from the active session's capabilities.
+ * @returns {{id: string, activity: string|undefined}} package (Android) or bundle id (iOS), plus the launch activity on Android.
+ */
+function currentApp() {
+    const caps = { ...driver.requestedCapabilities, ...driver.capabilities };
+    return driver.isAndroid
+        ? { id: caps.appPackage || caps['appium:appPackage'], activity: caps.appActivity || caps['appium:appActivity'] }
+        : { id: caps.bundleId || caps['appium:bundleId'] };
+}
+
+/**
+ * Loads the page object for the running platform, e.g. pageObject('CartPage').
+ * @param {string} name - page object file name.
+ * @returns {Object} page object instance.
+ */
+function pageObject(name) {
+    return require(`../ui/page-objects/${driver.isAndroid ? 'android' : 'ios'}/${name}`);
+}
+
+module.exports = { currentApp, pageObject };
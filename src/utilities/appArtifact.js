@@ -0,0 +1,57 @@
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+
+const hashes = new Map();
+
+function files(target) {
+    if (!fs.statSync(target).isDirectory()) {
+        return [target];
+    }
+    return fs.readdirSync(target).sort().flatMap((entry) => files(path.join(target, entry)));
+}
+
+/**
+ * Hashes an app artifact (.apk, .ipa or .app bundle directory). Results are memoized per path, size and
+ * modification time, so calling it once per test is cheap.
+ * @param {string} artifact - path to the artifact.
+ * @returns {string|undefined} sha256 hex digest, or undefined when the artifact does not exist.
+ */
+function appHash(artifact) {
+    if (!artifact || !fs.existsSync(artifact)) {
+        return undefined;
+    }
+    const stat = fs.statSync(artifact);
+    const key = `${artifact}:${stat.size}:${stat.mtimeMs}`;
+    if (!hashes.has(key)) {
+        const hash = crypto.createHash('sha256');
+        for (const file of files(artifact)) {
+            hash.update(path.relative(artifact, file));
+            hash.update(fs.readFileSync(file));
+        }
+        hashes.set(key, hash.digest('hex'));
+    }
+    return hashes.get(key);
+}
+
+let provisionedArtifact;
+
+/**
+ * Remembers the artifact of a session that was started without appium:app because the device already had it.
+ * @param {string} artifact - path to the artifact.
+ * @returns {void}
+ */
+function setProvisionedArtifact(artifact) {
+    provisionedArtifact = artifact;
+}
+
+/**
+ * Path of the app artifact the session was started with.
+ * @returns {string|undefined} value of the appium:app capability, or the provisioned artifact.
+ */
+function sessionArtifact() {
+    const caps = { ...driver.requestedCapabilities, ...driver.capabilities };
+    return caps['appium:App'] || caps['appium:app'] || caps.app || provisionedArtifact;
+}
+
+module.exports = { appHash, sessionArtifact, setProvisionedArtifact };
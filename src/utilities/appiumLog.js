@@ -0,0 +1,140 @@
+const fs = require('fs');
+
+const LINE = /^(\d{4}-\d{2}-\d{2}) (\d{2}):(\d{2}):(\d{2})[:.](\d{3})\s+(?:-\s+)?(.*)$/;
+
+/**
+ * Reads an Appium server log written with --log-timestamp (and --local-timezone) into entries of
+ * { time, prefix, message, instance, session }. instance is the driver instance tag (the '@ab12' in
+ * '[AndroidUiautomator2Driver@ab12 (1a2b3c4d)]') and session the 8-character session id prefix once known.
+ * Lines without a timestamp are continuation lines and are skipped.
+ * @param {string} file - log file path.
+ * @returns {Object[]} entries in log order.
+ */
+function readAppiumLog(file) {
+    if (!fs.existsSync(file)) {
+        return [];
+    }
+    const entries = [];
+    for (const line of fs.readFileSync(file, 'utf8').split('\n')) {
+        const match = line.match(LINE);
+        if (!match) {
+            continue;
+        }
+        const [, date, hours, minutes, seconds, millis, rest] = match;
+        const time = new Date(`${date}T${hours}:${minutes}:${seconds}.${millis}`).getTime();
+        const prefixMatch = rest.match(/^\[([^\]]+)\]\s*(.*)$/);
+        const prefix = prefixMatch ? prefixMatch[1] : '';
+        const message = prefixMatch ? prefixMatch[2] : rest;
+        entries.push({
+            time,
+            prefix,
+            message,
+            instance: (prefix.match(/@([0-9a-f]+)/) || [])[1],
+            session: (prefix.match(/\(([0-9a-f]{8})\)/) || [])[1],
+        });
+    }
+    return entries;
+}
+
+/**
+ * Session startup phases, each starting at the first log line matching its marker. Time between two markers
+ * is attributed to the phase of the earlier one. Markers are tried in this order, so the UiAutomator2 server
+ * lines (installing, uninstalling or instrumenting its packages) are claimed before the generic app install ones.
+ */
+const STARTUP_PHASES = [
+    { name: 'adb device discovery', marker: /Retrieving device list|Looking for devices|Connected devices|Using device:|Setting device id/i },
+    { name: 'uiautomator2 server boot', marker: /Starting UIAutomator2 server|instrument .*uiautomator2|Waiting up to \d+ms for UiAutomator2/i },
+    { name: 'uiautomator2 server install', marker: /io\.appium\.uiautomator2\.server|appium-uiautomator2-server|server packages|skipServerInstallation|Installing the server/i },
+    { name: 'app install', marker: /Installing '.*\.(apk|app|ipa)'|installApp|is already installed|will not be installed|application installation|Checking app cert|Uninstalling/i },
+    { name: 'app launch', marker: /UiAutomator2 server is ready|instrumentation process took|Starting '.*' and waiting|am start|Starting activity|appWaitActivity|Launching the application/i },
+];
+
+/**
+ * Breaks the creation of one session into phases from the Appium log.
+ * @param {Object[]} entries - result of readAppiumLog().
+ * @param {string} sessionId - full session id.
+ * @returns {{start: number, end: number, total: number, phases: Object}|null} phase durations in ms, or null when the
+ *   session is not in the log.
+ */
+function sessionStartupPhases(entries, sessionId) {
+    const created = entries.findIndex((entry) => entry.message.includes(sessionId) && /created|new session/i.test(entry.message));
+    if (created === -1) {
+        return null;
+    }
+    const instance = entries[created].instance;
+    const request = findLastIndex(entries, created, (entry) => /--> POST \/session\/?(\s|$)/.test(entry.message));
+    const first = instance ? entries.findIndex((entry) => entry.instance === instance) : created;
+    const startIndex = request !== -1 && request < first ? request : first;
+    const response = entries.findIndex((entry, index) => index > created && /<-- POST \/session\b(?!\/)/.test(entry.message));
+    const endIndex = response !== -1 ? response : created;
+
+    // Lines of other driver instances (parallel session creation on the same server) are ignored.
+    const own = entries.slice(startIndex, endIndex + 1)
+        .filter((entry) => !entry.instance || !instance || entry.instance === instance);
+    const phases = { 'session request': 0 };
+    let current = 'session request';
+    for (let index = 0; index < own.length; index++) {
+        const phase = STARTUP_PHASES.find((candidate) => candidate.marker.test(own[index].message));
+        if (phase) {
+            current = phase.name;
+        }
+        const next = own[index + 1];
+        if (next) {
+            phases[current] = (phases[current] || 0) + (next.time - own[index].time);
+        }
+    }
+
+    const start = entries[startIndex].time;
+    const end = entries[endIndex].time;
+    return { start, end, total: end - start, phases };
+}
+
+/**
+ * WebDriver requests of one session as the Appium server handled them: when the request arrived, when the response
+ * left, and how long the driver spent waiting on its proxied calls to the UiAutomator2 server or WebDriverAgent.
+ * Requests of one session are sequential, so proxy lines of the session between arrival and response belong to it.
+ * @param {Object[]} entries - result of readAppiumLog().
+ * @param {string} sessionId - full session id.
+ * @returns {Object[]} { method, path, received, responded, server, proxy, proxied } per request, in log order.
+ */
+function sessionRequests(entries, sessionId) {
+    const shortId = sessionId.slice(0, 8);
+    const requests = [];
+    let open = null;
+    let proxyStart = null;
+    for (const entry of entries) {
+        const http = entry.prefix === 'HTTP' && entry.message.match(/^(-->|<--) (\w+) (\/session\/([^/\s]+)\S*)/);
+        if (http && http[4] === sessionId) {
+            const [, direction, method, url] = http;
+            if (direction === '-->') {
+                open = { method, path: url.slice(`/session/${sessionId}`.length) || '/', received: entry.time, proxy: 0, proxied: 0 };
+            } else if (open) {
+                requests.push({ ...open, responded: entry.time, server: entry.time - open.received });
+                open = null;
+            }
+            continue;
+        }
+        if (!open || entry.session !== shortId) {
+            continue;
+        }
+        if (/^Proxying \[/.test(entry.message)) {
+            proxyStart = entry.time;
+        } else if (proxyStart !== null && /^Got response with status|^Got an unexpected response/.test(entry.message)) {
+            open.proxy += entry.time - proxyStart;
+            open.proxied += 1;
+            proxyStart = null;
+        }
+    }
+    return requests;
+}
+
+function findLastIndex(entries, before, predicate) {
+    for (let index = before; index >= 0; index--) {
+        if (predicate(entries[index])) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+module.exports = { readAppiumLog, sessionStartupPhases, sessionRequests };
@@ -0,0 +1,36 @@
+const ELEMENT_KEY = 'element-6066-11e4-a52e-4f735466cecf';
+
+/**
+ * Taps the same element several times in a single W3C actions request: one element lookup and one
+ * round trip regardless of the tap count.
+ * @param {WebdriverIO.Element} element - element to tap, resolved once.
+ * @param {number} count - number of taps.
+ * @param {Object} [options]
+ * @param {number} [options.interval=80] - pause between taps in milliseconds, long enough for the app to register each one.
+ * @returns {void}
+ */
+async function tapRepeatedly(element, count, { interval = 80 } = {}) {
+    if (count <= 0) {
+        return;
+    }
+    const { elementId } = await element;
+    const actions = [];
+    for (let i = 0; i < count; i++) {
+        actions.push(
+            { type: 'pointerMove', duration: 0, origin: { [ELEMENT_KEY]: elementId }, x: 0, y: 0 },
+            { type: 'pointerDown', button: 0 },
+            { type: 'pause', duration: 10 },
+            { type: 'pointerUp', button: 0 },
+            { type: 'pause', duration: interval },
+        );
+    }
+    await driver.performActions([{
+        type: 'pointer',
+        id: 'finger1',
+        parameters: { pointerType: 'touch' },
+        actions,
+    }]);
+    await driver.releaseActions();
+}
+
+module.exports = { tapRepeatedly };
@@ -0,0 +1,81 @@
+const PageObjectTracer = require('./PageObjectTracer');
+
+/**
+ * Times every WebDriver command of a worker once and hands the timings to its subscribers (CommandLatencyService,
+ * TraceService, TrendService). Fed by the beforeCommand/afterCommand hooks of CommandTimingService. Commands nest
+ * (element commands issue find commands), so open commands are kept on a stack and matched by name when they end.
+ */
+class CommandTimer {
+    constructor() {
+        this.open = [];
+        this.listeners = [];
+    }
+
+    /**
+     * Registers a listener called with ('start', entry) when a command is sent and ('end', entry) when it returns.
+     * entry is { commandName, args, start, path, nested } and gains end, duration, result and error on 'end'; it is
+     * shared between listeners, which must not modify it.
+     * @param {Function} listener - callback.
+     * @returns {void}
+     */
+    subscribe(listener) {
+        this.listeners.push(listener);
+    }
+
+    /**
+     * Opens a command; called from beforeCommand.
+     * @param {string} commandName - WebDriver command name.
+     * @param {Array} args - command arguments.
+     * @returns {void}
+     */
+    start(commandName, args) {
+        const entry = { commandName, args, start: Date.now(), path: PageObjectTracer.currentPath(), nested: this.open.length > 0 };
+        this.open.push(entry);
+        this.emit('start', entry);
+    }
+
+    /**
+     * Closes the innermost open command of that name; called from afterCommand.
+     * @param {string} commandName - WebDriver command name.
+     * @param {Array} args - command arguments.
+     * @param {*} result - command result.
+     * @param {Error} [error] - error the command failed with.
+     * @returns {void}
+     */
+    end(commandName, args, result, error) {
+        const index = this.open.map((entry) => entry.commandName).lastIndexOf(commandName);
+        if (index === -1) {
+            return;
+        }
+        const [entry] = this.open.splice(index, 1);
+        entry.end = Date.now();
+        entry.duration = entry.end - entry.start;
+        entry.result = result;
+        entry.error = error;
+        this.emit('end', entry);
+    }
+
+    /**
+     * Innermost command still waiting for its result.
+     * @returns {Object|undefined} open entry.
+     */
+    current() {
+        return this.open[this.open.length - 1];
+    }
+
+    /**
+     * True when no command is in flight.
+     * @returns {boolean}
+     */
+    idle() {
+        return this.open.length === 0;
+    }
+
+    emit(event, entry) {
+        for (const listener of this.listeners) {
+            listener(event, entry);
+        }
+    }
+}
+
+module.exports = new CommandTimer();
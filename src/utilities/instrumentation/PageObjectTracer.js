@@ -0,0 +1,141 @@
+const Module = require('module');
+const path = require('path');
+const { AsyncLocalStorage } = require('async_hooks');
+
+const SRC = path.join(__dirname, '..', '..');
+const INSTRUMENTED = Symbol('instrumented');
+
+/**
+ * Tracks which page-object method is running so WebDriver commands can be attributed to it. Async methods
+ * of page objects (src/ui) and of the PascalCase utility singletons (src/utilities) are wrapped in place; the
+ * call path survives awaits through AsyncLocalStorage, so nested calls produce paths such as
+ * CheckoutPage.enterShippingAddressAndroid → populateFormAndroid.
+ */
+class PageObjectTracer {
+    constructor() {
+        this.storage = new AsyncLocalStorage();
+        this.listeners = [];
+    }
+
+    /**
+     * Wraps the async methods of every loaded page-object and utility singleton. Safe to call repeatedly.
+     * @returns {void}
+     */
+    instrumentLoadedModules() {
+        for (const [file, module] of Object.entries(require.cache)) {
+            this.instrumentModule(file, module.exports);
+        }
+    }
+
+    /**
+     * Wraps page objects and utility singletons as they are required from now on, so modules a test requires
+     * lazily (e.g. a platform page object inside an it block) are attributed too. Safe to call repeatedly.
+     * @returns {void}
+     */
+    instrumentOnRequire() {
+        if (this.requireHooked) {
+            return;
+        }
+        this.requireHooked = true;
+        const tracer = this;
+        const load = Module._load;
+        Module._load = function (request, parent, isMain) {
+            const exports = load.call(this, request, parent, isMain);
+            if (request.startsWith('.') && exports && typeof exports === 'object') {
+                tracer.instrumentModule(Module._resolveFilename(request, parent, isMain), exports);
+            }
+            return exports;
+        };
+    }
+
+    instrumentModule(file, exports) {
+        const relative = path.relative(SRC, file);
+        const isPageObject = relative.startsWith(`ui${path.sep}`);
+        const isUtility = relative.startsWith(`utilities${path.sep}`) && /^[A-Z]/.test(path.basename(file));
+        if ((isPageObject || isUtility) && exports && typeof exports === 'object') {
+            this.instrument(exports, path.basename(file, '.js'));
+        }
+    }
+
+    /**
+     * Wraps the async methods found on an instance's prototype chain.
+     * @param {Object} instance - page object or utility singleton.
+     * @param {string} owner - name used in call paths, e.g. 'CartPage'.
+     * @returns {void}
+     */
+    instrument(instance, owner) {
+        if (instance[INSTRUMENTED]) {
+            return;
+        }
+        Object.defineProperty(instance, INSTRUMENTED, { value: true });
+
+        const tracer = this;
+        for (let proto = Object.getPrototypeOf(instance); proto && proto !== Object.prototype; proto = Object.getPrototypeOf(proto)) {
+            for (const [name, descriptor] of Object.entries(Object.getOwnPropertyDescriptors(proto))) {
+                const method = descriptor.value;
+                if (typeof method !== 'function' || method.constructor.name !== 'AsyncFunction' || Object.hasOwn(instance, name)) {
+                    continue;
+                }
+                instance[name] = function (...args) {
+                    return tracer.run(owner, name, () => method.apply(this, args));
+                };
+            }
+        }
+    }
+
+    /**
+     * Runs a function as a named frame of the current call path and notifies listeners on entry and exit.
+     * @param {string} owner - page object name.
+     * @param {string} method - method name.
+     * @param {Function} fn - async function to run.
+     * @returns {Promise<*>} result of fn.
+     */
+    run(owner, method, fn) {
+        const parent = this.storage.getStore() || [];
+        const frames = [...parent, { owner, method }];
+        return this.storage.run(frames, async () => {
+            const start = Date.now();
+            this.emit('enter', frames, start);
+            try {
+                return await fn();
+            } finally {
+                this.emit('exit', frames, start, Date.now());
+            }
+        });
+    }
+
+    /**
+     * Current call path, e.g. 'CheckoutPage.enterShippingAddressAndroid → populateFormAndroid'; the owner is
+     * repeated only when it changes.
+     * @returns {string|null} call path, or null outside page-object methods.
+     */
+    currentPath() {
+        return this.format(this.storage.getStore());
+    }
+
+    format(frames) {
+        if (!frames || frames.length === 0) {
+            return null;
+        }
+        return frames
+            .map((frame, index) => (index > 0 && frames[index - 1].owner === frame.owner ? frame.method : `${frame.owner}.${frame.method}`))
+            .join(' → ');
+    }
+
+    /**
+     * Registers a listener called with (event, frames, start, end) for 'enter' and 'exit' events.
+     * @param {Function} listener - callback.
+     * @returns {void}
+     */
+    subscribe(listener) {
+        this.listeners.push(listener);
+    }
+
+    emit(event, frames, start, end) {
+        for (const listener of this.listeners) {
+            listener(event, frames, start, end);
+        }
+    }
+}
+
+module.exports = new PageObjectTracer();
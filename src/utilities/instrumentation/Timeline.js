@@ -0,0 +1,69 @@
+const TRACKS = { flow: 1, commands: 2, idle: 3 };
+
+/**
+ * Collects spans for a worker in Chrome Trace Event format (loadable in chrome://tracing and Perfetto).
+ * Suites, hooks, tests and page-object methods go on the 'flow' track, WebDriver commands on 'commands',
+ * and gaps between commands on 'idle'.
+ */
+class Timeline {
+    constructor() {
+        this.events = [];
+        this.pid = Number(String(process.env.WDIO_WORKER_ID || process.pid).replace(/\D/g, '')) || process.pid;
+    }
+
+    /**
+     * Records a completed span.
+     * @param {string} name - span name.
+     * @param {string} category - e.g. 'suite', 'hook', 'test', 'page-object', 'command'.
+     * @param {number} start - start time in ms since epoch.
+     * @param {number} end - end time in ms since epoch.
+     * @param {Object} [args] - extra details shown in the trace viewer.
+     * @param {string} [track='flow'] - 'flow', 'commands' or 'idle'.
+     * @returns {void}
+     */
+    add(name, category, start, end, args = {}, track = 'flow') {
+        this.events.push({
+            name,
+            cat: category,
+            ph: 'X',
+            ts: start * 1000,
+            dur: Math.max(0, end - start) * 1000,
+            pid: this.pid,
+            tid: TRACKS[track],
+            args,
+        });
+    }
+
+    /**
+     * Runs a function and records it as a span.
+     * @param {string} name - span name.
+     * @param {string} category - span category.
+     * @param {Function} fn - async function to time.
+     * @returns {Promise<*>} result of fn.
+     */
+    async span(name, category, fn) {
+        const start = Date.now();
+        try {
+            return await fn();
+        } finally {
+            this.add(name, category, start, Date.now());
+        }
+    }
+
+    /**
+     * Returns the trace document and clears the collected events.
+     * @param {string} processName - label for this worker in the viewer, e.g. the spec file name.
+     * @returns {Object} trace in JSON object format.
+     */
+    flush(processName) {
+        const metadata = [
+            { name: 'process_name', ph: 'M', pid: this.pid, tid: 0, args: { name: processName } },
+            ...Object.entries(TRACKS).map(([track, tid]) => ({ name: 'thread_name', ph: 'M', pid: this.pid, tid, args: { name: track } })),
+        ];
+        const trace = { traceEvents: [...metadata, ...this.events.sort((a, b) => a.ts - b.ts)], displayTimeUnit: 'ms' };
+        this.events = [];
+        return trace;
+    }
+}
+
+module.exports = new Timeline();
@@ -0,0 +1,30 @@
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+
+const CAPTURE_COMMANDS = ['elementClick', 'performActions', 'execute', 'executeScript', 'back', 'activateApp'];
+const SNAPSHOT_DIR = path.join(__dirname, '..', '..', 'data', 'page-sources');
+const captured = new Set();
+
+/**
+ * Saves the page source after commands that can change the screen, when CAPTURE_PAGE_SOURCE is set.
+ * Identical sources are stored once, named by content hash, for the offline selector check.
+ * @param {string} commandName - command that just finished.
+ * @returns {void}
+ */
+async function capturePageSource(commandName) {
+    if (!process.env.CAPTURE_PAGE_SOURCE || !CAPTURE_COMMANDS.includes(commandName)) {
+        return;
+    }
+    const source = await driver.getPageSource();
+    const hash = crypto.createHash('sha1').update(source).digest('hex').slice(0, 12);
+    if (captured.has(hash)) {
+        return;
+    }
+    captured.add(hash);
+    const dir = path.join(SNAPSHOT_DIR, driver.isAndroid ? 'android' : 'ios');
+    fs.mkdirSync(dir, { recursive: true });
+    fs.writeFileSync(path.join(dir, `${hash}.xml`), source);
+}
+
+module.exports = { capturePageSource };
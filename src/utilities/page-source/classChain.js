@@ -0,0 +1,113 @@
+const { descendants } = require('./parseXml');
+const { compilePredicate } = require('./predicate');
+
+/**
+ * Parses an iOS class chain such as **\/XCUIElementTypeCell[`name BEGINSWITH "A"`][$type == "X"$]/XCUIElementTypeButton[2]
+ * into segments of { descendant, type, filters }.
+ */
+function parse(source) {
+    const segments = [];
+    let position = 0;
+    let descendant = false;
+
+    while (position < source.length) {
+        if (source.startsWith('**/', position)) {
+            descendant = true;
+            position += 3;
+            continue;
+        }
+        const typeMatch = source.slice(position).match(/^(\*|XCUIElementType\w+)/);
+        if (!typeMatch) {
+            throw new Error(`Invalid class chain at ${position}: ${source}`);
+        }
+        position += typeMatch[0].length;
+
+        const filters = [];
+        while (source[position] === '[') {
+            const close = findClose(source, position);
+            const body = source.slice(position + 1, close);
+            if (body.startsWith('`') && body.endsWith('`')) {
+                filters.push({ kind: 'predicate', match: compilePredicate(body.slice(1, -1)) });
+            } else if (body.startsWith('$') && body.endsWith('$')) {
+                filters.push({ kind: 'descendantPredicate', match: compilePredicate(body.slice(1, -1)) });
+            } else if (/^-?\d+$/.test(body)) {
+                filters.push({ kind: 'index', index: Number(body) });
+            } else {
+                throw new Error(`Invalid class chain filter [${body}] in ${source}`);
+            }
+            position = close + 1;
+        }
+
+        segments.push({ descendant, type: typeMatch[0], filters });
+        descendant = false;
+        if (position < source.length) {
+            if (source[position] !== '/') {
+                throw new Error(`Invalid class chain at ${position}: ${source}`);
+            }
+            position++;
+        }
+    }
+    if (descendant) {
+        throw new Error(`Class chain cannot end with **/: ${source}`);
+    }
+    return segments;
+}
+
+/**
+ * Finds the bracket closing the filter that opens at the given position, skipping quoted predicate text.
+ */
+function findClose(source, open) {
+    const quote = source[open + 1] === '`' || source[open + 1] === '$' ? source[open + 1] : null;
+    if (quote) {
+        const end = source.indexOf(`${quote}]`, open + 2);
+        if (end === -1) {
+            throw new Error(`Unterminated class chain filter in ${source}`);
+        }
+        return end + 1;
+    }
+    const end = source.indexOf(']', open);
+    if (end === -1) {
+        throw new Error(`Unterminated class chain filter in ${source}`);
+    }
+    return end;
+}
+
+function typeOf(node) {
+    return node.attributes.type ?? node.tag;
+}
+
+/**
+ * Applies one segment to a set of context nodes, mirroring WebDriverAgent's query chaining: the
+ * type selects children (or all descendants after **\/), predicates filter, and an index picks from
+ * the resulting ordered set (1-based, negative counts from the end).
+ */
+function applySegment(contexts, { descendant, type, filters }) {
+    let nodes = contexts.flatMap((context) => (descendant ? descendants(context) : context.children));
+    nodes = [...new Set(nodes)].filter((node) => type === '*' || typeOf(node) === type);
+
+    for (const filter of filters) {
+        if (filter.kind === 'predicate') {
+            nodes = nodes.filter(filter.match);
+        } else if (filter.kind === 'descendantPredicate') {
+            nodes = nodes.filter((node) => descendants(node).some(filter.match));
+        } else {
+            const index = filter.index > 0 ? filter.index - 1 : nodes.length + filter.index;
+            nodes = index >= 0 && index < nodes.length ? [nodes[index]] : [];
+        }
+    }
+    return nodes;
+}
+
+/**
+ * Evaluates an '-ios class chain' locator value against a parsed page source. The chain starts at the
+ * application element, like WebDriverAgent queries do.
+ * @param {Object} document - result of parseXml().
+ * @param {string} expression - class chain.
+ * @returns {Object[]} matching nodes.
+ */
+function evaluateClassChain(document, expression) {
+    const application = descendants(document).find((node) => typeOf(node) === 'XCUIElementTypeApplication');
+    return parse(expression).reduce(applySegment, [application || document]);
+}
+
+module.exports = { evaluateClassChain };
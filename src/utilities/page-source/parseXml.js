@@ -0,0 +1,81 @@
+const ENTITIES = { amp: '&', lt: '<', gt: '>', quot: '"', apos: "'" };
+
+/**
+ * Decodes the XML entities Appium emits in attribute values.
+ * @param {string} value - raw attribute value.
+ * @returns {string} decoded value.
+ */
+function decode(value) {
+    return value.replace(/&(#x[0-9a-f]+|#\d+|\w+);/gi, (match, entity) => {
+        if (entity[0] === '#') {
+            return String.fromCodePoint(entity[1].toLowerCase() === 'x' ? parseInt(entity.slice(2), 16) : parseInt(entity.slice(1), 10));
+        }
+        return ENTITIES[entity] ?? match;
+    });
+}
+
+/**
+ * Parses an Appium page source into a tree of { tag, attributes, children, parent } nodes. Only elements
+ * and attributes are kept; text content, comments and processing instructions are skipped because
+ * neither UiAutomator2 nor XCUITest put data there.
+ * @param {string} xml - page source returned by driver.getPageSource().
+ * @returns {Object} synthetic document node whose children are the top-level elements.
+ */
+function parseXml(xml) {
+    const document = { tag: '#document', attributes: {}, children: [], parent: null };
+    const tagPattern = /<(\/?)([A-Za-z_][\w.:-]*)((?:\s+[^\s=/>]+\s*=\s*(?:"[^"]*"|'[^']*'))*)\s*(\/?)>|<!--[\s\S]*?-->|<\?[\s\S]*?\?>|<!\[CDATA\[[\s\S]*?\]\]>|<![^>]*>/g;
+    const attributePattern = /([^\s=/>]+)\s*=\s*(?:"([^"]*)"|'([^']*)')/g;
+    let current = document;
+    let match;
+
+    while ((match = tagPattern.exec(xml)) !== null) {
+        const [, closing, tag, rawAttributes, selfClosing] = match;
+        if (!tag) {
+            continue;
+        }
+        if (closing) {
+            if (current.tag !== tag) {
+                throw new Error(`Malformed page source: </${tag}> closes <${current.tag}>`);
+            }
+            current = current.parent;
+            continue;
+        }
+
+        const attributes = {};
+        let attribute;
+        attributePattern.lastIndex = 0;
+        while ((attribute = attributePattern.exec(rawAttributes)) !== null) {
+            attributes[attribute[1]] = decode(attribute[2] ?? attribute[3]);
+        }
+        const node = { tag, attributes, children: [], parent: current };
+        current.children.push(node);
+        if (!selfClosing) {
+            current = node;
+        }
+    }
+
+    if (current !== document) {
+        throw new Error(`Malformed page source: <${current.tag}> is never closed`);
+    }
+    return document;
+}
+
+/**
+ * Lists every element below a node in document order.
+ * @param {Object} node - parsed node.
+ * @returns {Object[]} descendants, depth first.
+ */
+function descendants(node) {
+    const result = [];
+    const stack = [...node.children].reverse();
+    while (stack.length) {
+        const next = stack.pop();
+        result.push(next);
+        for (let i = next.children.length - 1; i >= 0; i--) {
+            stack.push(next.children[i]);
+        }
+    }
+    return result;
+}
+
+module.exports = { parseXml, descendants };
@@ -0,0 +1,230 @@
+const KEYWORDS = ['AND', 'OR', 'NOT', 'CONTAINS', 'BEGINSWITH', 'ENDSWITH', 'LIKE', 'MATCHES', 'IN', 'TRUE', 'FALSE', 'YES', 'NO', 'NIL', 'NULL'];
+
+/**
+ * Splits an NSPredicate format string into tokens.
+ */
+function tokenize(source) {
+    const tokens = [];
+    const pattern = /\s*(?:(==|!=|<>|<=|>=|=<|=>|&&|\|\||[=<>!(){},])|("(?:[^"\\]|\\.)*"|'(?:[^'\\]|\\.)*')|(-?\d+(?:\.\d+)?)|(\[[cdn]+\])|([A-Za-z_$][\w.$]*))/gy;
+    let match;
+    while (pattern.lastIndex < source.length) {
+        const start = pattern.lastIndex;
+        match = pattern.exec(source);
+        if (!match) {
+            if (/^\s*$/.test(source.slice(start))) {
+                break;
+            }
+            throw new Error(`Invalid predicate at ${start}: ${source}`);
+        }
+        const [, operator, string, number, modifier, word] = match;
+        if (operator) {
+            tokens.push({ type: 'op', value: operator });
+        } else if (string) {
+            tokens.push({ type: 'value', value: string.slice(1, -1).replace(/\\(.)/g, '$1') });
+        } else if (number) {
+            tokens.push({ type: 'value', value: Number(number) });
+        } else if (modifier) {
+            tokens.push({ type: 'modifier', value: modifier.slice(1, -1) });
+        } else if (KEYWORDS.includes(word.toUpperCase())) {
+            tokens.push({ type: 'keyword', value: word.toUpperCase() });
+        } else {
+            tokens.push({ type: 'key', value: word });
+        }
+    }
+    return tokens;
+}
+
+/**
+ * Recursive descent parser producing a node => boolean function.
+ */
+class Parser {
+    constructor(source) {
+        this.source = source;
+        this.tokens = tokenize(source);
+        this.position = 0;
+    }
+
+    parse() {
+        const predicate = this.or();
+        if (this.position < this.tokens.length) {
+            throw new Error(`Unexpected token "${this.tokens[this.position].value}" in predicate: ${this.source}`);
+        }
+        return predicate;
+    }
+
+    or() {
+        let left = this.and();
+        while (this.accept('keyword', 'OR') || this.accept('op', '||')) {
+            const right = this.and();
+            const previous = left;
+            left = (node) => previous(node) || right(node);
+        }
+        return left;
+    }
+
+    and() {
+        let left = this.not();
+        while (this.accept('keyword', 'AND') || this.accept('op', '&&')) {
+            const right = this.not();
+            const previous = left;
+            left = (node) => previous(node) && right(node);
+        }
+        return left;
+    }
+
+    not() {
+        if (this.accept('keyword', 'NOT') || this.accept('op', '!')) {
+            const inner = this.not();
+            return (node) => !inner(node);
+        }
+        if (this.accept('op', '(')) {
+            const inner = this.or();
+            this.require('op', ')');
+            return inner;
+        }
+        return this.comparison();
+    }
+
+    comparison() {
+        const left = this.operand();
+        const operatorToken = this.tokens[this.position++];
+        if (!operatorToken || !['op', 'keyword'].includes(operatorToken.type)) {
+            throw new Error(`Expected an operator in predicate: ${this.source}`);
+        }
+        const operator = operatorToken.value;
+        const modifier = this.tokens[this.position]?.type === 'modifier' ? this.tokens[this.position++].value : '';
+        const right = this.operand();
+        const compare = comparator(operator, modifier, this.source);
+        return (node) => compare(left(node), right(node));
+    }
+
+    operand() {
+        const token = this.tokens[this.position++];
+        if (!token) {
+            throw new Error(`Unexpected end of predicate: ${this.source}`);
+        }
+        if (token.type === 'value') {
+            return () => token.value;
+        }
+        if (token.type === 'keyword' && ['TRUE', 'YES'].includes(token.value)) {
+            return () => true;
+        }
+        if (token.type === 'keyword' && ['FALSE', 'NO'].includes(token.value)) {
+            return () => false;
+        }
+        if (token.type === 'keyword' && ['NIL', 'NULL'].includes(token.value)) {
+            return () => null;
+        }
+        if (token.type === 'op' && token.value === '{') {
+            const values = [];
+            while (!this.accept('op', '}')) {
+                values.push(this.operand()());
+                this.accept('op', ',');
+            }
+            return () => values;
+        }
+        if (token.type === 'key') {
+            return (node) => attribute(node, token.value);
+        }
+        throw new Error(`Unexpected token "${token.value}" in predicate: ${this.source}`);
+    }
+
+    accept(type, value) {
+        const token = this.tokens[this.position];
+        if (token && token.type === type && token.value === value) {
+            this.position++;
+            return true;
+        }
+        return false;
+    }
+
+    require(type, value) {
+        if (!this.accept(type, value)) {
+            throw new Error(`Expected "${value}" in predicate: ${this.source}`);
+        }
+    }
+}
+
+/**
+ * Reads an element attribute the way WebDriverAgent exposes it, including the wd-prefixed aliases.
+ */
+function attribute(node, key) {
+    const name = key.replace(/^wd([A-Z])/, (match, first) => first.toLowerCase());
+    if (name === 'type' || name === 'elementType') {
+        return node.attributes.type ?? node.tag;
+    }
+    const value = node.attributes[name];
+    if (value === 'true' || value === 'false') {
+        return value === 'true';
+    }
+    return value ?? null;
+}
+
+function comparator(operator, modifier, source) {
+    const normalize = (value) => {
+        if (typeof value !== 'string') {
+            return value;
+        }
+        let result = value;
+        if (modifier.includes('c')) {
+            result = result.toLowerCase();
+        }
+        if (modifier.includes('d')) {
+            result = result.normalize('NFD').replace(/[\u0300-\u036f]/g, '');
+        }
+        return result;
+    };
+    const strings = (fn) => (left, right) => typeof left === 'string' && typeof right === 'string'
+        && fn(normalize(left), normalize(right));
+    const loose = (left, right) => {
+        if (typeof left === 'boolean' || typeof right === 'boolean') {
+            return Boolean(left === 'true' || left === true || left === 1) === Boolean(right === 'true' || right === true || right === 1);
+        }
+        if (typeof right === 'number' && left !== null) {
+            return Number(left) === right;
+        }
+        return normalize(left) === normalize(right);
+    };
+
+    switch (operator) {
+        case '=':
+        case '==': return loose;
+        case '!=':
+        case '<>': return (left, right) => !loose(left, right);
+        case '<': return (left, right) => Number(left) < Number(right);
+        case '>': return (left, right) => Number(left) > Number(right);
+        case '<=':
+        case '=<': return (left, right) => Number(left) <= Number(right);
+        case '>=':
+        case '=>': return (left, right) => Number(left) >= Number(right);
+        case 'CONTAINS': return strings((left, right) => left.includes(right));
+        case 'BEGINSWITH': return strings((left, right) => left.startsWith(right));
+        case 'ENDSWITH': return strings((left, right) => left.endsWith(right));
+        case 'LIKE': return strings((left, right) => wildcard(right).test(left));
+        case 'MATCHES': return strings((left, right) => new RegExp(`^(?:${right})$`, 's').test(left));
+        case 'IN': return (left, right) => Array.isArray(right) && right.some((value) => loose(left, value));
+        default: throw new Error(`Unsupported operator "${operator}" in predicate: ${source}`);
+    }
+}
+
+function wildcard(pattern) {
+    const escaped = pattern.replace(/[.+^${}()|[\]\\]/g, '\\$&').replace(/\*/g, '.*').replace(/\?/g, '.');
+    return new RegExp(`^${escaped}$`, 's');
+}
+
+const cache = new Map();
+
+/**
+ * Compiles an NSPredicate format string as accepted by '-ios predicate string' into a node matcher.
+ * Supports comparisons, string operators with [cd] modifiers, IN with {} lists, AND/OR/NOT and parentheses.
+ * @param {string} source - predicate format string.
+ * @returns {function(Object): boolean} matcher for parsed page-source nodes.
+ */
+function compilePredicate(source) {
+    if (!cache.has(source)) {
+        cache.set(source, new Parser(source).parse());
+    }
+    return cache.get(source);
+}
+
+module.exports = { compilePredicate };
@@ -0,0 +1,174 @@
+const { descendants } = require('./parseXml');
+const { evaluateUiSelector } = require('./uiSelector');
+const { evaluateClassChain } = require('./classChain');
+const { compilePredicate } = require('./predicate');
+const { evaluateXPath } = require('./xpath');
+
+/**
+ * Attributes the UiAutomator2 CSS converter maps to page-source attributes.
+ */
+const ANDROID_CSS_ATTRIBUTES = {
+    id: 'resource-id',
+    'resource-id': 'resource-id',
+    description: 'content-desc',
+    'content-desc': 'content-desc',
+    text: 'text',
+    class: 'class',
+};
+
+/**
+ * Splits a WebdriverIO selector string into the W3C locator strategy and value the driver receives,
+ * following WebdriverIO's strategy detection for native apps.
+ * @param {string} selector - selector as written in a page object.
+ * @returns {{using: string, value: string}} locator strategy and value.
+ */
+function resolveStrategy(selector) {
+    if (selector.startsWith('~')) {
+        return { using: 'accessibility id', value: selector.slice(1) };
+    }
+    if (selector.startsWith('android=')) {
+        return { using: '-android uiautomator', value: selector.slice('android='.length) };
+    }
+    if (selector.startsWith('-ios class chain:')) {
+        return { using: '-ios class chain', value: selector.slice('-ios class chain:'.length) };
+    }
+    if (selector.startsWith('-ios predicate string:')) {
+        return { using: '-ios predicate string', value: selector.slice('-ios predicate string:'.length) };
+    }
+    if (selector.startsWith('id=')) {
+        return { using: 'id', value: selector.slice(3) };
+    }
+    if (selector.startsWith('/') || selector.startsWith('(')) {
+        return { using: 'xpath', value: selector };
+    }
+    if (/^[A-Za-z][\w.]*$/.test(selector)) {
+        return { using: 'class name', value: selector };
+    }
+    return { using: 'css selector', value: selector };
+}
+
+/**
+ * Locator as the driver receives it, for requests that bypass WebdriverIO's element commands (macro steps call the
+ * driver's findElement directly), converted the way WebdriverIO converts it; XCUITest has no CSS strategy. On iOS, tag[attribute="value"]
+ * becomes an XPath on the XCUIElementType; on Android, [id="..."] becomes a resource-id lookup.
+ * @param {string} selector - page-object selector.
+ * @param {'android'|'ios'} platform - session platform.
+ * @returns {{using: string, value: string}} locator strategy and value.
+ */
+function driverLocator(selector, platform) {
+    const locator = resolveStrategy(selector);
+    if (locator.using !== 'css selector') {
+        return locator;
+    }
+    const attribute = selector.match(/^(\w*)\[([\w-]+)=(?:"([^"]*)"|'([^']*)')\]$/);
+    if (platform === 'ios') {
+        if (!attribute) {
+            throw new Error(`Selector cannot be sent in a macro on iOS: ${selector}`);
+        }
+        const [, tag, name, doubleQuoted, singleQuoted] = attribute;
+        const type = !tag ? '*' : tag.startsWith('XCUIElementType') ? tag : `XCUIElementType${tag[0].toUpperCase()}${tag.slice(1)}`;
+        return { using: 'xpath', value: `//${type}[@${name}="${doubleQuoted ?? singleQuoted}"]` };
+    }
+    if (attribute && !attribute[1] && attribute[2] === 'id') {
+        return { using: 'id', value: attribute[3] ?? attribute[4] };
+    }
+    return locator;
+}
+
+/**
+ * Evaluates a simple CSS selector (tag, #id, .class and [attribute="value"] parts) the way the
+ * UiAutomator2 driver converts it; on iOS WebdriverIO sends tag[attribute] selectors as XPath,
+ * which is matched on tag and attribute here as well.
+ */
+function cssSelector(nodes, value, platform) {
+    const match = value.match(/^([\w.]*)((?:#[\w:/.-]+|\.[\w.]+|\[[\w-]+(?:[~^$*]?=(?:"[^"]*"|'[^']*'|[^\]]*))?\])*)$/);
+    if (!match) {
+        throw new Error(`Unsupported CSS selector: ${value}`);
+    }
+    const [, tag, rest] = match;
+    const conditions = [];
+    if (tag) {
+        const iosType = `XCUIElementType${tag[0].toUpperCase()}${tag.slice(1)}`;
+        conditions.push((node) => node.tag === tag || node.tag.endsWith(`.${tag}`) || node.attributes.class === tag
+            || (platform === 'ios' && node.tag === iosType));
+    }
+    const partPattern = /#([\w:/.-]+)|\.([\w.]+)|\[([\w-]+)(?:([~^$*]?=)(?:"([^"]*)"|'([^']*)'|([^\]]*)))?\]/g;
+    let part;
+    while ((part = partPattern.exec(rest)) !== null) {
+        const [, id, className, name, operator, doubleQuoted, singleQuoted, bare] = part;
+        if (id) {
+            conditions.push((node) => matchesResourceId(node.attributes['resource-id'], id));
+        } else if (className) {
+            conditions.push((node) => (node.attributes.class ?? node.tag) === className || node.tag.endsWith(`.${className}`));
+        } else {
+            const attribute = platform === 'android' ? ANDROID_CSS_ATTRIBUTES[name] ?? name : name;
+            const expected = doubleQuoted ?? singleQuoted ?? bare;
+            conditions.push((node) => {
+                const actual = node.attributes[attribute];
+                if (operator === undefined) {
+                    return actual !== undefined;
+                }
+                if (actual === undefined) {
+                    return false;
+                }
+                switch (operator) {
+                    case '*=': return actual.includes(expected);
+                    case '^=': return actual.startsWith(expected);
+                    case '$=': return actual.endsWith(expected);
+                    case '~=': return actual.split(/\s+/).includes(expected);
+                    default: return attribute === 'resource-id' ? matchesResourceId(actual, expected) : actual === expected;
+                }
+            });
+        }
+    }
+    return nodes.filter((node) => conditions.every((condition) => condition(node)));
+}
+
+/**
+ * UiAutomator2 accepts ids with or without the 'package:id/' prefix.
+ */
+function matchesResourceId(actual, expected) {
+    if (!actual) {
+        return false;
+    }
+    return expected.includes(':id/') ? actual === expected : actual.endsWith(`:id/${expected}`);
+}
+
+/**
+ * Evaluates a selector against a parsed page source with the semantics of the UiAutomator2 and XCUITest
+ * drivers: accessibility id, id, class name, CSS, XPath (the subset in xpath.js), UiSelector/UiScrollable, class chain
+ * and predicate string.
+ * @param {Object} document - result of parseXml().
+ * @param {string} selector - WebdriverIO selector.
+ * @param {string} platform - 'android' or 'ios'.
+ * @returns {Object[]} matching nodes in document order.
+ */
+function findAll(document, selector, platform) {
+    const { using, value } = resolveStrategy(selector);
+    const nodes = descendants(document).filter((node) => !['hierarchy', 'AppiumAUT'].includes(node.tag));
+
+    switch (using) {
+        case 'accessibility id':
+            return nodes.filter((node) => node.attributes[platform === 'android' ? 'content-desc' : 'name'] === value);
+        case 'id':
+            return platform === 'android'
+                ? nodes.filter((node) => matchesResourceId(node.attributes['resource-id'], value))
+                : nodes.filter((node) => node.attributes.name === value);
+        case 'class name':
+            return nodes.filter((node) => (node.attributes.class ?? node.attributes.type ?? node.tag) === value);
+        case 'css selector':
+            return cssSelector(nodes, value, platform);
+        case '-android uiautomator':
+            return evaluateUiSelector(document, value);
+        case '-ios class chain':
+            return evaluateClassChain(document, value);
+        case '-ios predicate string':
+            return nodes.filter(compilePredicate(value));
+        case 'xpath':
+            return evaluateXPath(document, value);
+        default:
+            throw new Error(`Unsupported locator strategy "${using}" for snapshot evaluation: ${selector}`);
+    }
+}
+
+module.exports = { resolveStrategy, driverLocator, findAll };
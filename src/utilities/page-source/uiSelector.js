@@ -0,0 +1,228 @@
+const { descendants } = require('./parseXml');
+
+const BOOLEAN_ATTRIBUTES = {
+    checkable: 'checkable',
+    checked: 'checked',
+    clickable: 'clickable',
+    enabled: 'enabled',
+    focusable: 'focusable',
+    focused: 'focused',
+    longClickable: 'long-clickable',
+    scrollable: 'scrollable',
+    selected: 'selected',
+};
+
+const STRING_ATTRIBUTES = {
+    text: 'text',
+    description: 'content-desc',
+    resourceId: 'resource-id',
+    className: 'class',
+    packageName: 'package',
+};
+
+/**
+ * Tokenizes and parses UiSelector / UiScrollable Java expressions into a list of method calls.
+ */
+class Parser {
+    constructor(source) {
+        this.source = source.trim().replace(/;$/, '');
+        this.position = 0;
+    }
+
+    parse() {
+        const selector = this.selector();
+        this.skipWhitespace();
+        if (this.position < this.source.length) {
+            this.fail('unexpected trailing input');
+        }
+        return selector;
+    }
+
+    selector() {
+        this.skipWhitespace();
+        let type = 'UiSelector';
+        if (this.source.startsWith('new ', this.position)) {
+            this.position += 4;
+            this.skipWhitespace();
+            type = this.identifier();
+            this.expect('(');
+            const constructorArgs = this.args();
+            if (type === 'UiScrollable') {
+                return { type, calls: this.calls(), container: constructorArgs[0] };
+            }
+            if (type !== 'UiSelector') {
+                this.fail(`unsupported class ${type}`);
+            }
+        }
+        return { type, calls: this.calls() };
+    }
+
+    calls() {
+        const calls = [];
+        this.skipWhitespace();
+        while (this.source[this.position] === '.') {
+            this.position++;
+            const method = this.identifier();
+            this.expect('(');
+            calls.push({ method, args: this.args() });
+            this.skipWhitespace();
+        }
+        return calls;
+    }
+
+    args() {
+        const args = [];
+        this.skipWhitespace();
+        if (this.source[this.position] === ')') {
+            this.position++;
+            return args;
+        }
+        for (;;) {
+            args.push(this.value());
+            this.skipWhitespace();
+            const next = this.source[this.position++];
+            if (next === ')') {
+                return args;
+            }
+            if (next !== ',') {
+                this.fail('expected "," or ")"');
+            }
+        }
+    }
+
+    value() {
+        this.skipWhitespace();
+        const char = this.source[this.position];
+        if (char === '"') {
+            return this.string();
+        }
+        if (this.source.startsWith('new ', this.position)) {
+            return this.selector();
+        }
+        const literal = this.source.slice(this.position).match(/^(-?\d+|true|false)/);
+        if (!literal) {
+            this.fail('expected a string, number, boolean or selector');
+        }
+        this.position += literal[0].length;
+        return literal[0] === 'true' ? true : literal[0] === 'false' ? false : Number(literal[0]);
+    }
+
+    string() {
+        let result = '';
+        this.position++;
+        while (this.position < this.source.length) {
+            const char = this.source[this.position++];
+            if (char === '\\') {
+                const escaped = this.source[this.position++];
+                result += { n: '\n', t: '\t' }[escaped] ?? escaped;
+            } else if (char === '"') {
+                return result;
+            } else {
+                result += char;
+            }
+        }
+        this.fail('unterminated string');
+    }
+
+    identifier() {
+        const match = this.source.slice(this.position).match(/^[A-Za-z_]\w*/);
+        if (!match) {
+            this.fail('expected an identifier');
+        }
+        this.position += match[0].length;
+        return match[0];
+    }
+
+    expect(char) {
+        this.skipWhitespace();
+        if (this.source[this.position] !== char) {
+            this.fail(`expected "${char}"`);
+        }
+        this.position++;
+    }
+
+    skipWhitespace() {
+        while (/\s/.test(this.source[this.position] || '')) {
+            this.position++;
+        }
+    }
+
+    fail(message) {
+        throw new Error(`Invalid UiSelector at ${this.position}: ${message} in ${this.source}`);
+    }
+}
+
+/**
+ * Builds a node predicate for one UiSelector call, or returns null for structural calls
+ * (instance, childSelector, fromParent) that are handled by the matcher.
+ */
+function predicateFor({ method, args }) {
+    const [arg] = args;
+    const stringMatch = method.match(/^(text|description|resourceId|className|packageName)(Contains|StartsWith|Matches)?$/);
+    if (stringMatch) {
+        const attribute = STRING_ATTRIBUTES[stringMatch[1]];
+        switch (stringMatch[2]) {
+            case 'Contains': return (node) => (node.attributes[attribute] ?? '').includes(arg);
+            case 'StartsWith': return (node) => (node.attributes[attribute] ?? '').startsWith(arg);
+            case 'Matches': return (node) => new RegExp(`^(?:${arg})$`, 's').test(node.attributes[attribute] ?? '');
+            default: return (node) => (node.attributes[attribute] ?? (attribute === 'class' ? node.tag : undefined)) === arg;
+        }
+    }
+    if (method in BOOLEAN_ATTRIBUTES) {
+        return (node) => node.attributes[BOOLEAN_ATTRIBUTES[method]] === String(arg);
+    }
+    if (method === 'index') {
+        return (node) => Number(node.attributes.index ?? node.parent.children.indexOf(node)) === arg;
+    }
+    if (['instance', 'childSelector', 'fromParent'].includes(method)) {
+        return null;
+    }
+    throw new Error(`Unsupported UiSelector method: ${method}`);
+}
+
+/**
+ * Finds the nodes matched by a parsed UiSelector below the given roots, following UiAutomator semantics:
+ * attribute calls filter, childSelector searches descendants of each match, fromParent searches the whole
+ * subtree of each match's parent, and instance picks the n-th overall match.
+ */
+function match(selector, roots) {
+    const predicates = selector.calls.map(predicateFor).filter(Boolean);
+    let candidates = roots.flatMap(descendants).filter((node) => node.tag !== 'hierarchy'
+        && predicates.every((predicate) => predicate(node)));
+
+    for (const call of selector.calls) {
+        if (call.method === 'childSelector') {
+            candidates = match(call.args[0], candidates);
+        } else if (call.method === 'fromParent') {
+            candidates = match(call.args[0], unique(candidates.map((node) => node.parent)));
+        }
+    }
+
+    const instance = selector.calls.find((call) => call.method === 'instance');
+    return instance ? candidates.slice(instance.args[0], instance.args[0] + 1) : unique(candidates);
+}
+
+function unique(nodes) {
+    return [...new Set(nodes)];
+}
+
+/**
+ * Evaluates an '-android uiautomator' locator value against a parsed page source.
+ * UiScrollable(...).scrollIntoView(selector) and similar resolve to the selector they scroll to.
+ * @param {Object} document - result of parseXml().
+ * @param {string} expression - UiSelector or UiScrollable Java expression.
+ * @returns {Object[]} matching nodes.
+ */
+function evaluateUiSelector(document, expression) {
+    const selector = new Parser(expression).parse();
+    if (selector.type === 'UiScrollable') {
+        const target = selector.calls.map((call) => call.args.find((arg) => arg && arg.type === 'UiSelector')).find(Boolean);
+        if (!target) {
+            throw new Error(`UiScrollable without a target selector: ${expression}`);
+        }
+        return match(target, [document]);
+    }
+    return match(selector, [document]);
+}
+
+module.exports = { evaluateUiSelector };
@@ -0,0 +1,126 @@
+const { descendants } = require('./parseXml');
+
+/**
+ * Splits an XPath location path such as //XCUIElementTypeCell[@name="A"]/XCUIElementTypeButton[2] into steps
+ * of { descendant, name, predicates }. Only the subset page objects and driverLocator() produce is supported:
+ * child and descendant steps, name and * tests, and predicates made of positions, @attribute, @attribute="value",
+ * contains() and starts-with() joined with 'and'. A whole path may be wrapped as (path)[n].
+ */
+function parse(source) {
+    let path = source.trim();
+    const wrapped = path.match(/^\((.*)\)((?:\[\d+\])+)$/s);
+    const outer = wrapped ? [...wrapped[2].matchAll(/\[(\d+)\]/g)].map((match) => Number(match[1])) : [];
+    if (wrapped) {
+        path = wrapped[1];
+    }
+
+    const steps = [];
+    let position = 0;
+    while (position < path.length) {
+        let descendant = false;
+        if (path.startsWith('//', position)) {
+            descendant = true;
+            position += 2;
+        } else if (path[position] === '/') {
+            position++;
+        } else if (position > 0) {
+            throw new Error(`Unsupported XPath at ${position}: ${source}`);
+        }
+        const name = path.slice(position).match(/^(\*|[A-Za-z_][\w.-]*)/);
+        if (!name) {
+            throw new Error(`Unsupported XPath at ${position}: ${source}`);
+        }
+        position += name[0].length;
+
+        const predicates = [];
+        while (path[position] === '[') {
+            const close = findClose(path, position, source);
+            predicates.push(predicate(path.slice(position + 1, close), source));
+            position = close + 1;
+        }
+        steps.push({ descendant, name: name[0], predicates });
+    }
+    if (steps.length === 0) {
+        throw new Error(`Empty XPath: ${source}`);
+    }
+    return { steps, outer };
+}
+
+/**
+ * Finds the bracket closing the predicate that opens at the given position, skipping quoted text.
+ */
+function findClose(path, open, source) {
+    let quote = null;
+    for (let i = open + 1; i < path.length; i++) {
+        if (quote) {
+            quote = path[i] === quote ? null : quote;
+        } else if (path[i] === '"' || path[i] === "'") {
+            quote = path[i];
+        } else if (path[i] === ']') {
+            return i;
+        }
+    }
+    throw new Error(`Unterminated XPath predicate in ${source}`);
+}
+
+/**
+ * Compiles one predicate body into a position (number) or a node => boolean condition.
+ */
+function predicate(body, source) {
+    if (/^\s*\d+\s*$/.test(body)) {
+        return Number(body);
+    }
+    const conditions = body.split(/\s+and\s+(?=(?:[^"']|"[^"]*"|'[^']*')*$)/).map((term) => {
+        const literal = `(?:"([^"]*)"|'([^']*)')`;
+        let match = term.match(new RegExp(`^\\s*@([\\w:-]+)\\s*(?:=\\s*${literal})?\\s*$`));
+        if (match) {
+            const [, name, doubleQuoted, singleQuoted] = match;
+            const expected = doubleQuoted ?? singleQuoted;
+            return (node) => (expected === undefined ? node.attributes[name] !== undefined : node.attributes[name] === expected);
+        }
+        match = term.match(new RegExp(`^\\s*(contains|starts-with)\\(\\s*@([\\w:-]+)\\s*,\\s*${literal}\\s*\\)\\s*$`));
+        if (match) {
+            const [, fn, name, doubleQuoted, singleQuoted] = match;
+            const expected = doubleQuoted ?? singleQuoted;
+            return (node) => {
+                const actual = node.attributes[name] ?? '';
+                return fn === 'contains' ? actual.includes(expected) : actual.startsWith(expected);
+            };
+        }
+        throw new Error(`Unsupported XPath predicate [${body}] in ${source}`);
+    });
+    return (node) => conditions.every((condition) => condition(node));
+}
+
+/**
+ * Applies one step to the context nodes. A descendant step (//) selects the matching children of each context and
+ * of each of its descendants, so positions count among siblings as they do in XPath.
+ */
+function applyStep(contexts, { descendant, name, predicates }) {
+    const parents = descendant ? contexts.flatMap((context) => [context, ...descendants(context)]) : contexts;
+    return [...new Set(parents)].flatMap((parent) => {
+        let nodes = parent.children.filter((node) => name === '*' || node.tag === name);
+        for (const filter of predicates) {
+            nodes = typeof filter === 'number' ? nodes.slice(filter - 1, filter) : nodes.filter(filter);
+        }
+        return nodes;
+    });
+}
+
+/**
+ * Evaluates an 'xpath' locator value against a parsed page source, in document order.
+ * @param {Object} document - result of parseXml().
+ * @param {string} expression - XPath location path.
+ * @returns {Object[]} matching nodes.
+ */
+function evaluateXPath(document, expression) {
+    const { steps, outer } = parse(expression);
+    const order = new Map(descendants(document).map((node, index) => [node, index]));
+    let nodes = [...new Set(steps.reduce(applyStep, [document]))].sort((a, b) => order.get(a) - order.get(b));
+    for (const index of outer) {
+        nodes = nodes.slice(index - 1, index);
+    }
+    return nodes;
+}
+
+module.exports = { evaluateXPath };
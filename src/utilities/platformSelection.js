@@ -0,0 +1,81 @@
+const path = require('path');
+const { expandSpecs } = require('./specFiles');
+
+/**
+ * Spec files passed on the command line with --spec (repeatable, also --spec=<file>), resolved from the cwd.
+ * @param {string[]} argv - process arguments.
+ * @returns {string[]|null} absolute spec files, or null when no --spec was given.
+ */
+function requestedSpecs(argv) {
+    const patterns = [];
+    argv.forEach((arg, index) => {
+        if (arg === '--spec' && argv[index + 1]) {
+            patterns.push(...argv[index + 1].split(','));
+        } else if (arg.startsWith('--spec=')) {
+            patterns.push(...arg.slice('--spec='.length).split(','));
+        }
+    });
+    return patterns.length ? expandSpecs(patterns, process.cwd()) : null;
+}
+
+function ownsAny(capability, selected, baseDir) {
+    return expandSpecs(capability.specs || [], baseDir).some((file) => selected.includes(file));
+}
+
+/**
+ * Why a capability cannot run in this invocation, or null when it can: none of its specs were selected,
+ * or the host cannot run the platform (iOS simulators need macOS).
+ */
+function skipReason(capability, selected, baseDir, hostPlatform, checkHost) {
+    if (selected && !ownsAny(capability, selected, baseDir)) {
+        return 'no selected specs';
+    }
+    if (checkHost && capability.platformName === 'iOS' && hostPlatform !== 'darwin') {
+        return `iOS cannot run on ${hostPlatform}`;
+    }
+    return null;
+}
+
+/**
+ * Keeps the capabilities this run can use, so no session is attempted (and retried for connectionRetryTimeout ×
+ * connectionRetryCount) for a platform the selected specs do not need or the host cannot run. Specs are only used
+ * to choose when at least one selected spec belongs to a capability; specs outside every capability's globs (such as
+ * src/tests/benchmarks/cart-seeding.bench.js) keep all capabilities, and wdio reports specs that do not exist.
+ * @param {Object[]} capabilities - capabilities from the config.
+ * @param {Object} [options]
+ * @param {string[]} [options.argv=process.argv] - command line to read --spec from.
+ * @param {string} [options.baseDir] - directory the capability specs are relative to.
+ * @param {string} [options.hostPlatform=process.platform] - host OS.
+ * @param {boolean} [options.checkHost=true] - drop platforms the host cannot run (off when replaying recordings).
+ * @returns {Object[]} active capabilities.
+ */
+function selectCapabilities(capabilities, {
+    argv = process.argv,
+    baseDir = path.resolve(__dirname, '../config'),
+    hostPlatform = process.platform,
+    checkHost = true,
+} = {}) {
+    let selected = requestedSpecs(argv);
+    if (selected && !capabilities.some((capability) => ownsAny(capability, selected, baseDir))) {
+        selected = null;
+    }
+    return capabilities.filter((capability) => {
+        const reason = skipReason(capability, selected, baseDir, hostPlatform, checkHost);
+        if (reason && !process.env.WDIO_WORKER_ID) {
+            console.log(`Skipping ${capability.platformName} capability (${capability['appium:deviceName']}): ${reason}`);
+        }
+        return !reason;
+    });
+}
+
+/**
+ * Appium ports the active capabilities connect to.
+ * @param {Object[]} capabilities - active capabilities.
+ * @param {number|null} defaultPort - port used by capabilities without their own, null when those need no server.
+ * @returns {number[]} distinct ports.
+ */
+function appiumPorts(capabilities, defaultPort) {
+    return [...new Set(capabilities.map((capability) => capability.port ?? defaultPort).filter((port) => port))];
+}
+
+module.exports = { selectCapabilities, appiumPorts, requestedSpecs };
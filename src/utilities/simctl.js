@@ -0,0 +1,29 @@
+const { execFile } = require('child_process');
+
+/**
+ * Resolves the simulator udid of the current session, falling back to the booted simulator.
+ * @returns {string} simulator udid or 'booted'.
+ */
+function sessionUdid() {
+    const caps = driver.capabilities || {};
+    return caps['appium:udid'] || caps.udid || 'booted';
+}
+
+/**
+ * Runs an 'xcrun simctl' subcommand on the host.
+ * @param {string[]} args - simctl arguments.
+ * @returns {Promise<string>} stdout of the command.
+ */
+function simctl(args) {
+    return new Promise((resolve, reject) => {
+        execFile('xcrun', ['simctl', ...args], { timeout: 60000 }, (error, stdout, stderr) => {
+            if (error) {
+                error.message = `xcrun simctl ${args.join(' ')} failed: ${stderr || error.message}`;
+                return reject(error);
+            }
+            resolve(stdout.trim());
+        });
+    });
+}
+
+module.exports = { simctl, sessionUdid };
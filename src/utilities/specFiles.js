@@ -0,0 +1,70 @@
+const fs = require('fs');
+const path = require('path');
+
+/**
+ * Converts a spec glob ('*', '**' and '?') into a regular expression over '/'-separated paths.
+ */
+function globToRegExp(pattern) {
+    let source = '';
+    for (let index = 0; index < pattern.length; index++) {
+        const char = pattern[index];
+        if (pattern.startsWith('**/', index)) {
+            source += '(?:.*/)?';
+            index += 2;
+        } else if (pattern.startsWith('**', index)) {
+            source += '.*';
+            index += 1;
+        } else if (char === '*') {
+            source += '[^/]*';
+        } else if (char === '?') {
+            source += '[^/]';
+        } else {
+            source += char.replace(/[.+^${}()|[\]\\]/g, '\\$&');
+        }
+    }
+    return new RegExp(`^${source}$`);
+}
+
+function walk(dir) {
+    if (!fs.existsSync(dir)) {
+        return [];
+    }
+    return fs.readdirSync(dir, { withFileTypes: true }).flatMap((entry) => {
+        const file = path.join(dir, entry.name);
+        return entry.isDirectory() ? walk(file) : [file];
+    });
+}
+
+/**
+ * Expands spec patterns the way the wdio launcher does: relative to the config directory, sorted, deduplicated.
+ * Nested arrays (spec groups run in one worker) are not expanded.
+ * @param {string[]} patterns - spec files or globs.
+ * @param {string} baseDir - directory relative patterns are resolved against.
+ * @returns {string[]} absolute spec file paths.
+ */
+function expandSpecs(patterns, baseDir) {
+    const files = patterns.filter((pattern) => typeof pattern === 'string').flatMap((pattern) => {
+        const absolute = path.resolve(baseDir, pattern).split(path.sep).join('/');
+        if (!/[*?]/.test(absolute)) {
+            return [absolute];
+        }
+        const root = absolute.slice(0, absolute.search(/[*?]/)).replace(/[^/]*$/, '');
+        const matcher = globToRegExp(absolute);
+        return walk(root).map((file) => file.split(path.sep).join('/')).filter((file) => matcher.test(file)).sort();
+    });
+    return [...new Set(files)].map((file) => path.normalize(file));
+}
+
+/**
+ * Directory the config's relative spec paths are resolved against.
+ * @param {Object} config - wdio config as passed to launcher hooks.
+ * @returns {string} absolute directory.
+ */
+function specBaseDir(config) {
+    if (config.configFilePath) {
+        return path.dirname(config.configFilePath);
+    }
+    return config.rootDir || path.resolve('src/config');
+}
+
+module.exports = { expandSpecs, specBaseDir };
@@ -0,0 +1,47 @@
+/**
+ * Returns the value at the given percentile using nearest-rank on a sorted copy of the samples.
+ * @param {number[]} samples - measured values.
+ * @param {number} p - percentile between 0 and 100.
+ * @returns {number} value at the percentile, or NaN for an empty sample set.
+ */
+function percentile(samples, p) {
+    if (samples.length === 0) {
+        return NaN;
+    }
+    const sorted = [...samples].sort((a, b) => a - b);
+    const rank = Math.ceil((p / 100) * sorted.length);
+    return sorted[Math.min(sorted.length - 1, Math.max(0, rank - 1))];
+}
+
+/**
+ * Summarizes a set of durations into count, mean, p50, p95, p99 and max.
+ * @param {number[]} samples - durations in milliseconds.
+ * @returns {Object} summary with values rounded to whole milliseconds.
+ */
+function summarize(samples) {
+    const total = samples.reduce((sum, value) => sum + value, 0);
+    return {
+        count: samples.length,
+        mean: samples.length ? Math.round(total / samples.length) : NaN,
+        p50: percentile(samples, 50),
+        p95: percentile(samples, 95),
+        p99: percentile(samples, 99),
+        max: samples.length ? Math.max(...samples) : NaN
+    };
+}
+
+/**
+ * Buckets durations into power-of-two millisecond bins, e.g. { '<=16': 3, '<=32': 10 }.
+ * @param {number[]} samples - durations in milliseconds.
+ * @returns {Object} sample count per bin, keyed by the bin's upper bound.
+ */
+function histogram(samples) {
+    const bins = {};
+    for (const sample of samples) {
+        const bound = 2 ** Math.max(0, Math.ceil(Math.log2(Math.max(sample, 1))));
+        bins[bound] = (bins[bound] || 0) + 1;
+    }
+    return Object.fromEntries(Object.keys(bins).map(Number).sort((a, b) => a - b).map((bound) => [`<=${bound}`, bins[bound]]));
+}
+
+module.exports = { percentile, summarize, histogram };
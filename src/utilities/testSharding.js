@@ -0,0 +1,164 @@
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+
+const HISTORY_FILE = path.resolve('.perf/spec-history.json');
+const CLAIMS_DIR = path.resolve('.perf/test-claims');
+
+/**
+ * Test-level sharding: the same spec files run on several devices and each worker keeps only its share of the
+ * `it` blocks (describe-level hooks run only where a describe still has tests).
+ *
+ * Modes, chosen by environment:
+ *   TEST_SHARD=i/n     this process runs shard i of n (1-based), e.g. one wdio process per device in CI
+ *   TEST_SHARDS=n      capabilities are expanded into n copies and each copy takes one shard
+ *   TEST_SHARD_MODE=dynamic
+ *                      with TEST_SHARDS, every copy loads all tests and claims them one at a time; tests already
+ *                      claimed by another worker are skipped, so idle devices keep pulling work
+ *
+ * Static assignment balances tests longest-first from the per-test history kept by SpecSchedulerService, so every
+ * worker computes the same split. WebdriverIO's own --shard option splits spec files, not tests.
+ */
+
+/**
+ * Expands each capability into one copy per shard. Android copies get their own UiAutomator2 system port, iOS copies
+ * their own WebDriverAgent port; devices are taken from TEST_SHARD_DEVICES (comma separated serials/UDIDs), which
+ * must name one device per shard unless the capability's devices are assigned elsewhere. Copies sharing one device
+ * would only take turns on it.
+ * @param {Object[]} capabilities - capabilities from the config.
+ * @param {number} shards - number of shards; 0 or 1 returns the capabilities unchanged.
+ * @param {Object} [options]
+ * @param {function(Object): boolean} [options.devicesAssigned] - true for capabilities that get their devices from
+ *     somewhere else, e.g. the emulator farm, or need none, e.g. a replay.
+ * @returns {Object[]} capabilities, copies of one capability adjacent to each other.
+ */
+function expandCapabilities(capabilities, shards, { devicesAssigned = () => false } = {}) {
+    if (shards <= 1) {
+        return capabilities;
+    }
+    const devices = (process.env.TEST_SHARD_DEVICES || '').split(',').filter(Boolean);
+    const unassigned = capabilities.filter((capability) => !devicesAssigned(capability));
+    if (unassigned.length && devices.length < shards) {
+        throw new Error(`TEST_SHARDS=${shards} needs as many devices in TEST_SHARD_DEVICES `
+            + `(${unassigned.map((capability) => capability.platformName).join(', ')}), got ${devices.length}`);
+    }
+    // Workers inherit the launcher's environment, so all of them agree on the run the claims belong to.
+    process.env.TEST_SHARD_RUN ??= String(Date.now());
+    return capabilities.flatMap((capability) => Array.from({ length: shards }, (unused, index) => ({
+        ...capability,
+        ...(capability.platformName === 'Android' ? { 'appium:systemPort': 8200 + index } : { 'appium:wdaLocalPort': 8100 + index }),
+        ...(devices[index] && !devicesAssigned(capability) ? { 'appium:udid': devices[index] } : {}),
+    })));
+}
+
+/**
+ * Removes the test claims of earlier runs; called once by the launcher before workers start.
+ * @returns {void}
+ */
+function clearClaims() {
+    fs.rmSync(CLAIMS_DIR, { recursive: true, force: true });
+}
+
+/**
+ * Shard of the current worker, or null when test-level sharding is off.
+ * @returns {{index: number, total: number, dynamic: boolean}|null} 0-based shard index and shard count.
+ */
+function currentShard() {
+    const explicit = (process.env.TEST_SHARD || '').match(/^(\d+)\/(\d+)$/);
+    if (explicit) {
+        return { index: Number(explicit[1]) - 1, total: Number(explicit[2]), dynamic: false };
+    }
+    const total = Number(process.env.TEST_SHARDS || 0);
+    if (total > 1 && process.env.WDIO_WORKER_ID) {
+        const capabilityIndex = Number(process.env.WDIO_WORKER_ID.split('-')[0]);
+        return { index: capabilityIndex % total, total, dynamic: process.env.TEST_SHARD_MODE === 'dynamic' };
+    }
+    return null;
+}
+
+function testsOf(suite) {
+    return [...suite.tests, ...suite.suites.flatMap(testsOf)];
+}
+
+function historyKey(test) {
+    return `${path.relative(process.cwd(), test.file || '').split(path.sep).join('/')}::${test.fullTitle()}`;
+}
+
+/**
+ * Keeps the tests of the given shard: longest known tests are placed first on the least loaded shard, unknown
+ * tests count as the mean known duration.
+ */
+function pruneToShard(root, { index, total }) {
+    const history = fs.existsSync(HISTORY_FILE) ? JSON.parse(fs.readFileSync(HISTORY_FILE, 'utf8')).tests || {} : {};
+    const tests = testsOf(root).map((test, order) => {
+        const runs = history[historyKey(test)];
+        return { test, order, estimate: runs ? runs.reduce((sum, value) => sum + value, 0) / runs.length : undefined };
+    });
+    const known = tests.filter((entry) => entry.estimate !== undefined);
+    const fallback = known.length ? known.reduce((sum, entry) => sum + entry.estimate, 0) / known.length : 1;
+
+    const loads = new Array(total).fill(0);
+    const keep = new Set();
+    tests
+        .map((entry) => ({ ...entry, estimate: entry.estimate ?? fallback }))
+        .sort((a, b) => b.estimate - a.estimate || a.order - b.order)
+        .forEach((entry) => {
+            const shard = loads.indexOf(Math.min(...loads));
+            loads[shard] += entry.estimate;
+            if (shard === index) {
+                keep.add(entry.test);
+            }
+        });
+
+    const prune = (suite) => {
+        suite.tests = suite.tests.filter((test) => keep.has(test));
+        suite.suites.forEach(prune);
+    };
+    prune(root);
+}
+
+/**
+ * Claims a test for this worker; false when another worker already took it.
+ */
+function claim(test) {
+    const dir = path.join(CLAIMS_DIR, process.env.TEST_SHARD_RUN || 'default');
+    fs.mkdirSync(dir, { recursive: true });
+    const name = crypto.createHash('sha1').update(historyKey(test)).digest('hex');
+    try {
+        fs.closeSync(fs.openSync(path.join(dir, name), 'wx'));
+        return true;
+    } catch (error) {
+        if (error.code === 'EEXIST') {
+            return false;
+        }
+        throw error;
+    }
+}
+
+/**
+ * Hooks mocha's runner so the loaded suite is pruned (static) or guarded by a claiming root beforeEach
+ * (dynamic) before it runs. Loaded through mochaOpts.require.
+ * @returns {void}
+ */
+function register() {
+    const shard = currentShard();
+    if (!shard) {
+        return;
+    }
+    const { Runner } = require('mocha');
+    const run = Runner.prototype.run;
+    Runner.prototype.run = function (...args) {
+        if (shard.dynamic) {
+            this.suite.beforeEach('claim test', function () {
+                if (!claim(this.currentTest)) {
+                    this.skip();
+                }
+            });
+        } else {
+            pruneToShard(this.suite, shard);
+        }
+        return run.apply(this, args);
+    };
+}
+
+module.exports = { expandCapabilities, clearClaims, currentShard, register };
@@ -0,0 +1,106 @@
+const fs = require('fs');
+const path = require('path');
+
+/**
+ * Reads the trend store: one JSON row per line of
+ * { run, date, git, build, platform, device, kind, name, count, mean, p50, p95, max }.
+ * @param {string} file - store path.
+ * @returns {Object[]} rows in file order.
+ */
+function readTrends(file) {
+    if (!fs.existsSync(file)) {
+        return [];
+    }
+    return fs.readFileSync(file, 'utf8').split('\n').filter(Boolean).map((line) => JSON.parse(line));
+}
+
+/**
+ * Appends rows to the trend store. Appends of single lines are atomic enough for parallel workers.
+ * @param {string} file - store path.
+ * @param {Object[]} rows - rows to append.
+ * @returns {void}
+ */
+function appendTrends(file, rows) {
+    if (rows.length === 0) {
+        return;
+    }
+    fs.mkdirSync(path.dirname(file), { recursive: true });
+    fs.appendFileSync(file, rows.map((row) => `${JSON.stringify(row)}\n`).join(''));
+}
+
+/**
+ * Groups rows into series of one value per run, ordered by run date. A series is one kind/name on one platform
+ * and device; when a run recorded a series in several workers, the value is the mean of their values.
+ * @param {Object[]} rows - store rows.
+ * @param {string} metric - row field to follow, e.g. 'p95'.
+ * @returns {Map<string, Object>} series key → { kind, name, platform, device, points: [{ run, date, git, build, value }] }.
+ */
+function series(rows, metric) {
+    const all = new Map();
+    for (const row of rows) {
+        const key = [row.kind, row.name, row.platform, row.device].join('|');
+        if (!all.has(key)) {
+            all.set(key, { kind: row.kind, name: row.name, platform: row.platform, device: row.device, runs: new Map() });
+        }
+        const runs = all.get(key).runs;
+        if (!runs.has(row.run)) {
+            runs.set(row.run, { run: row.run, date: row.date, git: row.git, build: row.build, values: [] });
+        }
+        runs.get(row.run).values.push(row[metric]);
+    }
+    for (const entry of all.values()) {
+        entry.points = [...entry.runs.values()]
+            .map(({ values, ...point }) => ({ ...point, value: mean(values) }))
+            .sort((a, b) => a.date.localeCompare(b.date));
+        delete entry.runs;
+    }
+    return all;
+}
+
+/**
+ * Finds the most significant shift in a series: the split into a before and after segment with the largest
+ * Welch t statistic between the segment means. A shift is reported when t reaches minT and the relative change
+ * of the mean reaches minChange.
+ * @param {Object[]} points - series points with value.
+ * @param {Object} [options]
+ * @param {number} [options.minSegment=3] - fewest runs on each side of the split.
+ * @param {number} [options.minT=4] - t statistic the shift must reach.
+ * @param {number} [options.minChange=0.1] - relative change of the mean the shift must reach.
+ * @returns {Object|null} { index, before, after, change, t, point } where point is the first run after the shift.
+ */
+function changepoint(points, { minSegment = 3, minT = 4, minChange = 0.1 } = {}) {
+    let best = null;
+    for (let index = minSegment; index <= points.length - minSegment; index++) {
+        const before = points.slice(0, index).map((point) => point.value);
+        const after = points.slice(index).map((point) => point.value);
+        const t = welchT(before, after);
+        if (!best || Math.abs(t) > Math.abs(best.t)) {
+            best = { index, before: mean(before), after: mean(after), t };
+        }
+    }
+    if (!best || Math.abs(best.t) < minT || !best.before) {
+        return null;
+    }
+    const change = (best.after - best.before) / best.before;
+    if (Math.abs(change) < minChange) {
+        return null;
+    }
+    return { ...best, change, point: points[best.index] };
+}
+
+function welchT(a, b) {
+    const varianceOf = (values, average) => values.reduce((sum, value) => sum + (value - average) ** 2, 0) / Math.max(1, values.length - 1);
+    const meanA = a.reduce((sum, value) => sum + value, 0) / a.length;
+    const meanB = b.reduce((sum, value) => sum + value, 0) / b.length;
+    const error = Math.sqrt(varianceOf(a, meanA) / a.length + varianceOf(b, meanB) / b.length);
+    if (error === 0) {
+        return meanA === meanB ? 0 : Infinity * Math.sign(meanB - meanA);
+    }
+    return (meanB - meanA) / error;
+}
+
+function mean(values) {
+    return values.length ? Math.round(values.reduce((sum, value) => sum + value, 0) / values.length) : NaN;
+}
+
+module.exports = { readTrends, appendTrends, series, changepoint };